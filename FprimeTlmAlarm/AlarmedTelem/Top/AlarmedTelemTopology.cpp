@@ -15,20 +15,37 @@
 // This is also the namespace where the topology components are instantiated by FPP.
 namespace FprimeTlmAlarm {
 
-// Instantiate a malloc allocator for cmdSeq buffer allocation
+// Instantiate a malloc allocator for cmdSeq buffer and tlmAlarm table allocation
 Fw::MallocAllocator mallocator;
 
 // The reference topology divides the incoming clock signal (1Hz) into sub-signals: 1Hz, 1/2Hz, and 1/4Hz with 0 offset
 Svc::RateGroupDriver::DividerSet rateGroupDivisorsSet{{{1, 0}, {2, 0}, {4, 0}}};
 
 // Rate groups may supply a context token to each of the attached children whose purpose is set by the project. The
-// reference topology sets each token to zero as these contexts are unused in this project.
+// reference topology sets each token to zero as these contexts are unused, except for tlmAlarm which reads the token as
+// the scheduling group to evaluate. The tokens are set in configureTopology().
 U32 rateGroup1Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
 U32 rateGroup2Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
 U32 rateGroup3Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
 
 enum TopologyConstants {
     COMM_PRIORITY = 34,
+    TLM_SHM_MAX_CHANNELS = 1024,
+    TLM_ALARM_MEM_ID = 1,
+    TLM_ALARM_MAX_ALARMS = 256,
+    TLM_ALARM_MAX_CHANNELS = 128,
+    TLM_ALARM_HISTORY_DEPTH = 256,
+    TLM_ALARM_WORKERS = 0,
+    TLM_ALARM_WORKER_PRIORITY = RATE_GROUP_1_PRIORITY,
+};
+
+// POSIX shared-memory name of the last-value telemetry table published by tlmShmTap
+const char* const TLM_SHM_NAME = "/AlarmedTelem.tlm";
+
+// tlmAlarm scheduling groups, one per rate group driving tlmAlarm.run
+enum TlmAlarmSchedGroups {
+    TLM_ALARM_GROUP_1HZ = 0,
+    TLM_ALARM_GROUP_QUARTER_HZ = 1,
 };
 
 /**
@@ -42,6 +59,10 @@ void configureTopology() {
     // Rate group driver needs a divisor list
     rateGroupDriver.configure(rateGroupDivisorsSet);
 
+    // tlmAlarm evaluates the alarms of the scheduling group named by its context
+    rateGroup1Context[5] = TLM_ALARM_GROUP_1HZ;
+    rateGroup3Context[6] = TLM_ALARM_GROUP_QUARTER_HZ;
+
     // Rate groups require context arrays.
     rateGroup1.configure(rateGroup1Context, FW_NUM_ARRAY_ELEMENTS(rateGroup1Context));
     rateGroup2.configure(rateGroup2Context, FW_NUM_ARRAY_ELEMENTS(rateGroup2Context));
@@ -49,6 +70,15 @@ void configureTopology() {
 
     // Command sequencer needs to allocate memory to hold contents of command sequences
     cmdSeq.allocateBuffer(0, mallocator, 5 * 1024);
+
+    // Alarm tables are sized once here, nothing is allocated after startup
+    tlmAlarm.configure(TLM_ALARM_MEM_ID, mallocator, TLM_ALARM_MAX_ALARMS, TLM_ALARM_MAX_CHANNELS,
+                       TLM_ALARM_HISTORY_DEPTH);
+    // Raise TLM_ALARM_WORKERS to share alarm evaluation across cores, workers run at rateGroup1's priority
+    tlmAlarm.startWorkers(TLM_ALARM_WORKERS, TLM_ALARM_WORKER_PRIORITY, Default::STACK_SIZE);
+
+    // Telemetry tap is best effort: on failure it reports an event and drops updates
+    (void)tlmShmTap.configure(TLM_SHM_NAME, TLM_SHM_MAX_CHANNELS);
 }
 
 void setupTopology(const TopologyState& state) {
@@ -102,6 +132,9 @@ void teardownTopology(const TopologyState& state) {
 
     // Resource deallocation
     cmdSeq.deallocateBuffer(mallocator);
+    tlmAlarm.stopWorkers();
+    tlmAlarm.cleanup(mallocator);
+    tlmShmTap.cleanup();
 
     tearDownComponents(state);
 }
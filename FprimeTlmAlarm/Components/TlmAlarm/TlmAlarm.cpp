@@ -5,17 +5,420 @@
 // ======================================================================
 
 #include "FprimeTlmAlarm/Components/TlmAlarm/TlmAlarm.hpp"
+#include "Fw/Types/Assert.hpp"
+#include "Os/RawTime.hpp"
+
+#include <cstring>
+#include <new>
 
 namespace FprimeTlmAlarm {
 
+namespace {
+
+//! Decode a big-endian serialized telemetry value into a double for limit comparison
+//!
+//! \return false if the buffer is too short for the requested encoding
+bool decodeValue(const U8* bytes, FwSizeType length, AlarmValueType::T type, F64& value) {
+    FwSizeType size = 0;
+    switch (type) {
+        case AlarmValueType::UINT8:
+        case AlarmValueType::INT8:
+            size = 1;
+            break;
+        case AlarmValueType::UINT16:
+        case AlarmValueType::INT16:
+            size = 2;
+            break;
+        case AlarmValueType::UINT32:
+        case AlarmValueType::INT32:
+        case AlarmValueType::FLOAT32:
+            size = 4;
+            break;
+        default:
+            size = 8;
+            break;
+    }
+    if (length < size) {
+        return false;
+    }
+
+    U64 raw = 0;
+    for (FwSizeType i = 0; i < size; i++) {
+        raw = (raw << 8) | bytes[i];
+    }
+
+    switch (type) {
+        case AlarmValueType::UINT8:
+        case AlarmValueType::UINT16:
+        case AlarmValueType::UINT32:
+        case AlarmValueType::UINT64:
+            value = static_cast<F64>(raw);
+            break;
+        case AlarmValueType::INT8:
+            value = static_cast<F64>(static_cast<I8>(raw));
+            break;
+        case AlarmValueType::INT16:
+            value = static_cast<F64>(static_cast<I16>(raw));
+            break;
+        case AlarmValueType::INT32:
+            value = static_cast<F64>(static_cast<I32>(raw));
+            break;
+        case AlarmValueType::INT64:
+            value = static_cast<F64>(static_cast<I64>(raw));
+            break;
+        case AlarmValueType::FLOAT32: {
+            const U32 bits = static_cast<U32>(raw);
+            F32 f;
+            std::memcpy(&f, &bits, sizeof(f));
+            value = static_cast<F64>(f);
+            break;
+        }
+        default:
+            std::memcpy(&value, &raw, sizeof(value));
+            break;
+    }
+    return true;
+}
+
+//! Reserve a cache-line aligned table at the end of the arena
+//!
+//! \return byte offset of the table
+FwSizeType carve(FwSizeType& offset, FwSizeType bytes) {
+    const FwSizeType align = TlmAlarm::CACHE_LINE_BYTES;
+    const FwSizeType start = (offset + align - 1) & ~(align - 1);
+    offset = start + bytes;
+    return start;
+}
+
+}  // namespace
+
 // ----------------------------------------------------------------------
 // Component construction and destruction
 // ----------------------------------------------------------------------
 
-TlmAlarm ::TlmAlarm(const char* const compName) : TlmAlarmComponentBase(compName) {}
+TlmAlarm ::TlmAlarm(const char* const compName)
+    : TlmAlarmComponentBase(compName),
+      m_arena(nullptr),
+      m_memId(0),
+      m_arenaSize(0),
+      m_alarms(nullptr),
+      m_schedules(nullptr),
+      m_channels(nullptr),
+      m_chanLookup(nullptr),
+      m_slotHead(nullptr),
+      m_phaseLoad(nullptr),
+      m_history(nullptr),
+      m_due(nullptr),
+      m_results(nullptr),
+      m_maxAlarms(0),
+      m_maxChannels(0),
+      m_chanHashMask(0),
+      m_chanHashBits(0),
+      m_historyDepth(0),
+      m_historyFlushThreshold(0),
+      m_tick(),
+      m_alarmCount(0),
+      m_channelCount(0),
+      m_tickEvals(0),
+      m_tickTimeUsec(0),
+      m_maxTickTimeUsec(0),
+      m_tlmDropped(0),
+      m_tlmDroppedReported(0),
+      m_historyHead(0),
+      m_historyCount(0),
+      m_historyOverwritten(0),
+      m_historyDpsSent(0),
+      m_ticksSinceFlush(0),
+      m_cursors(),
+      m_numWorkers(0),
+      m_dueCount(0),
+      m_generation(0),
+      m_busyWorkers(0),
+      m_stopping(false) {}
 
 TlmAlarm ::~TlmAlarm() {}
 
+// ----------------------------------------------------------------------
+// Memory
+// ----------------------------------------------------------------------
+
+TlmAlarm::ArenaLayout TlmAlarm ::arenaLayout(U16 maxAlarms, U16 maxChannels, U32 historyDepth) {
+    U8 hashBits = 0;
+    while ((1U << hashBits) < 2U * maxChannels) {
+        hashBits++;
+    }
+
+    // Hot tables first, in the order a tick touches them
+    ArenaLayout layout;
+    FwSizeType offset = 0;
+    layout.slotHead = carve(offset, sizeof(U16) * NUM_SCHED_GROUPS * NUM_SCHED_SLOTS);
+    layout.alarms = carve(offset, sizeof(AlarmEntry) * maxAlarms);
+    layout.channels = carve(offset, sizeof(ChannelEntry) * maxChannels);
+    layout.due = carve(offset, sizeof(U16) * maxAlarms);
+    layout.results = carve(offset, sizeof(EvalResult) * maxAlarms);
+    layout.chanLookup = carve(offset, sizeof(U16) * (static_cast<FwSizeType>(1) << hashBits));
+    layout.chanHashBits = hashBits;
+    layout.history = carve(offset, sizeof(AlarmTransitionRecord) * historyDepth);
+    layout.schedules = carve(offset, sizeof(AlarmSchedule) * maxAlarms);
+    layout.phaseLoad = carve(offset, sizeof(U32) * NUM_SCHED_GROUPS * MAX_PERIOD);
+    layout.size = offset;
+    return layout;
+}
+
+FwSizeType TlmAlarm ::arenaSize(U16 maxAlarms, U16 maxChannels, U32 historyDepth) {
+    // Allocators only guarantee fundamental alignment, the slack lets the arena start on a cache line
+    return arenaLayout(maxAlarms, maxChannels, historyDepth).size + CACHE_LINE_BYTES - 1;
+}
+
+void TlmAlarm ::configure(FwEnumStoreType memId,
+                          Fw::MemAllocator& allocator,
+                          U16 maxAlarms,
+                          U16 maxChannels,
+                          U32 historyDepth) {
+    FW_ASSERT(m_arena == nullptr);
+    FW_ASSERT(maxAlarms > 0 && maxAlarms < NO_INDEX, maxAlarms);
+    FW_ASSERT(maxChannels > 0 && maxChannels <= MAX_CHANNELS_LIMIT, maxChannels);
+    FW_ASSERT(historyDepth > 0, historyDepth);
+
+    const FwSizeType requested = arenaSize(maxAlarms, maxChannels, historyDepth);
+    FwSizeType size = requested;
+    bool recoverable = false;
+    m_arena = allocator.allocate(memId, size, recoverable);
+    FW_ASSERT(m_arena != nullptr);
+    FW_ASSERT(size >= requested, static_cast<FwAssertArgType>(size), static_cast<FwAssertArgType>(requested));
+    m_memId = memId;
+    m_arenaSize = size;
+
+    const ArenaLayout layout = arenaLayout(maxAlarms, maxChannels, historyDepth);
+    const PlatformPointerCastType addr = reinterpret_cast<PlatformPointerCastType>(m_arena);
+    const FwSizeType misalign = static_cast<FwSizeType>(addr & (CACHE_LINE_BYTES - 1));
+    U8* const base = static_cast<U8*>(m_arena) + ((CACHE_LINE_BYTES - misalign) & (CACHE_LINE_BYTES - 1));
+    m_alarms = reinterpret_cast<AlarmEntry*>(base + layout.alarms);
+    m_schedules = reinterpret_cast<AlarmSchedule*>(base + layout.schedules);
+    m_channels = reinterpret_cast<ChannelEntry*>(base + layout.channels);
+    m_chanLookup = reinterpret_cast<U16*>(base + layout.chanLookup);
+    m_slotHead = reinterpret_cast<U16*>(base + layout.slotHead);
+    m_phaseLoad = reinterpret_cast<U32*>(base + layout.phaseLoad);
+    m_history = reinterpret_cast<AlarmTransitionRecord*>(base + layout.history);
+    m_due = reinterpret_cast<U16*>(base + layout.due);
+    m_results = reinterpret_cast<EvalResult*>(base + layout.results);
+
+    m_maxAlarms = maxAlarms;
+    m_maxChannels = maxChannels;
+    m_chanHashBits = layout.chanHashBits;
+    m_chanHashMask = static_cast<U16>((1U << m_chanHashBits) - 1);
+    m_historyDepth = historyDepth;
+    m_historyFlushThreshold = (historyDepth + 1) / 2;
+
+    for (U16 i = 0; i < maxAlarms; i++) {
+        m_alarms[i].nextInSlot = NO_INDEX;
+        m_schedules[i].inUse = false;
+    }
+    for (U16 i = 0; i < maxChannels; i++) {
+        m_channels[i].refCount = 0;
+        m_channels[i].valid = false;
+    }
+    for (U32 i = 0; i <= m_chanHashMask; i++) {
+        m_chanLookup[i] = NO_INDEX;
+    }
+    for (U32 i = 0; i < NUM_SCHED_GROUPS * NUM_SCHED_SLOTS; i++) {
+        m_slotHead[i] = NO_INDEX;
+    }
+    for (U32 i = 0; i < NUM_SCHED_GROUPS * MAX_PERIOD; i++) {
+        m_phaseLoad[i] = 0;
+    }
+    for (U32 i = 0; i < historyDepth; i++) {
+        (void)new (&m_history[i]) AlarmTransitionRecord();
+    }
+}
+
+void TlmAlarm ::cleanup(Fw::MemAllocator& allocator) {
+    if (m_arena == nullptr) {
+        return;
+    }
+    FW_ASSERT(m_numWorkers == 0, m_numWorkers);
+    for (U32 i = 0; i < m_historyDepth; i++) {
+        m_history[i].~AlarmTransitionRecord();
+    }
+    allocator.deallocate(m_memId, m_arena);
+    m_arena = nullptr;
+    m_alarms = nullptr;
+    m_schedules = nullptr;
+    m_channels = nullptr;
+    m_chanLookup = nullptr;
+    m_slotHead = nullptr;
+    m_phaseLoad = nullptr;
+    m_history = nullptr;
+    m_due = nullptr;
+    m_results = nullptr;
+}
+
+FwSizeType TlmAlarm ::arenaBytesUsed() const {
+    // Lookup, schedule and per-tick scratch tables are fully live once configured, the rest grows with the alarms
+    // and history
+    return (static_cast<FwSizeType>(m_chanHashMask) + 1) * sizeof(U16) +
+           NUM_SCHED_GROUPS * (NUM_SCHED_SLOTS * sizeof(U16) + MAX_PERIOD * sizeof(U32)) +
+           m_maxAlarms * (sizeof(U16) + sizeof(EvalResult)) +
+           m_alarmCount * (sizeof(AlarmEntry) + sizeof(AlarmSchedule)) + m_channelCount * sizeof(ChannelEntry) +
+           m_historyCount * sizeof(AlarmTransitionRecord);
+}
+
+// ----------------------------------------------------------------------
+// Parallel evaluation
+// ----------------------------------------------------------------------
+
+void TlmAlarm ::startWorkers(U8 numWorkers, FwTaskPriorityType priority, FwSizeType stackSize) {
+    FW_ASSERT(m_arena != nullptr);
+    FW_ASSERT(m_numWorkers == 0, m_numWorkers);
+    FW_ASSERT(numWorkers <= MAX_WORKERS, numWorkers);
+
+    for (U32 i = 0; i < numWorkers; i++) {
+        Worker& worker = m_workers[i];
+        worker.component = this;
+        worker.index = i + 1;
+        worker.generation = m_generation;
+        Os::TaskString name;
+        name.format("TlmAlarmW%u", static_cast<unsigned int>(worker.index));
+        const Os::Task::Status status =
+            worker.task.start(Os::Task::Arguments(name, workerRoutine, &worker, priority, stackSize));
+        FW_ASSERT(status == Os::Task::OP_OK, status);
+        m_numWorkers++;
+    }
+}
+
+void TlmAlarm ::stopWorkers() {
+    m_poolMutex.lock();
+    m_stopping = true;
+    m_poolMutex.unlock();
+    m_workReady.notifyAll();
+
+    for (U32 i = 0; i < m_numWorkers; i++) {
+        (void)m_workers[i].task.join();
+    }
+    m_numWorkers = 0;
+    m_stopping = false;
+}
+
+void TlmAlarm ::workerRoutine(void* arg) {
+    Worker* worker = static_cast<Worker*>(arg);
+    worker->component->workerLoop(worker->index, worker->generation);
+}
+
+void TlmAlarm ::workerLoop(U32 self, U32 generation) {
+    while (true) {
+        m_poolMutex.lock();
+        while (m_generation == generation && !m_stopping) {
+            m_workReady.wait(m_poolMutex);
+        }
+        if (m_stopping) {
+            m_poolMutex.unlock();
+            return;
+        }
+        generation = m_generation;
+        m_poolMutex.unlock();
+
+        evaluateChunks(self);
+
+        m_poolMutex.lock();
+        if (--m_busyWorkers == 0) {
+            m_workDone.notify();
+        }
+        m_poolMutex.unlock();
+    }
+}
+
+// ----------------------------------------------------------------------
+// Alarm table
+// ----------------------------------------------------------------------
+
+AlarmConfigStatus TlmAlarm ::addAlarm(U16 alarmId,
+                                      FwChanIdType chanId,
+                                      const AlarmValueType& valType,
+                                      F64 lowLimit,
+                                      F64 highLimit,
+                                      U8 schedGroup,
+                                      U16 period) {
+    FW_ASSERT(m_arena != nullptr);
+    AlarmConfigStatus status = AlarmConfigStatus::OK;
+    if (alarmId >= m_maxAlarms) {
+        status = AlarmConfigStatus::INVALID_ID;
+    } else if (m_schedules[alarmId].inUse) {
+        status = AlarmConfigStatus::ID_IN_USE;
+    } else if (!valType.isValid()) {
+        status = AlarmConfigStatus::INVALID_TYPE;
+    } else if (!(lowLimit <= highLimit)) {
+        status = AlarmConfigStatus::INVALID_LIMITS;
+    } else if (schedGroup >= NUM_SCHED_GROUPS) {
+        status = AlarmConfigStatus::INVALID_GROUP;
+    } else if (period == 0 || period > MAX_PERIOD || (period & (period - 1)) != 0) {
+        status = AlarmConfigStatus::INVALID_PERIOD;
+    }
+
+    const U16 chanIdx = (status == AlarmConfigStatus::OK) ? acquireChannel(chanId) : NO_INDEX;
+    if (status == AlarmConfigStatus::OK && chanIdx == NO_INDEX) {
+        status = AlarmConfigStatus::CHANNEL_TABLE_FULL;
+    }
+    if (status != AlarmConfigStatus::OK) {
+        this->log_WARNING_LO_AlarmConfigFailed(alarmId, status);
+        return status;
+    }
+
+    AlarmEntry& alarm = m_alarms[alarmId];
+    alarm.lowLimit = lowLimit;
+    alarm.highLimit = highLimit;
+    alarm.chanIdx = chanIdx;
+    alarm.valType = valType.e;
+    alarm.state = AlarmState::NO_DATA;
+
+    AlarmSchedule& sched = m_schedules[alarmId];
+    sched.period = period;
+    sched.phase = pickPhase(schedGroup, period);
+    sched.schedGroup = schedGroup;
+    sched.inUse = true;
+
+    // Push onto the front of the slot list, the evaluation order within a slot carries no meaning
+    U16& head = m_slotHead[schedGroup * NUM_SCHED_SLOTS + slotIndex(period, sched.phase)];
+    alarm.nextInSlot = head;
+    head = alarmId;
+    adjustLoad(sched, 1);
+    m_alarmCount++;
+
+    this->log_ACTIVITY_HI_AlarmAdded(alarmId, chanId, schedGroup, period, sched.phase);
+    return status;
+}
+
+AlarmConfigStatus TlmAlarm ::removeAlarm(U16 alarmId) {
+    FW_ASSERT(m_arena != nullptr);
+    AlarmConfigStatus status = AlarmConfigStatus::OK;
+    if (alarmId >= m_maxAlarms) {
+        status = AlarmConfigStatus::INVALID_ID;
+    } else if (!m_schedules[alarmId].inUse) {
+        status = AlarmConfigStatus::NOT_IN_USE;
+    }
+    if (status != AlarmConfigStatus::OK) {
+        this->log_WARNING_LO_AlarmConfigFailed(alarmId, status);
+        return status;
+    }
+
+    AlarmEntry& alarm = m_alarms[alarmId];
+    AlarmSchedule& sched = m_schedules[alarmId];
+    U16* link = &m_slotHead[sched.schedGroup * NUM_SCHED_SLOTS + slotIndex(sched.period, sched.phase)];
+    while (*link != alarmId) {
+        FW_ASSERT(*link != NO_INDEX, alarmId);
+        link = &m_alarms[*link].nextInSlot;
+    }
+    *link = alarm.nextInSlot;
+    alarm.nextInSlot = NO_INDEX;
+
+    adjustLoad(sched, -1);
+    releaseChannel(alarm.chanIdx);
+    sched.inUse = false;
+    m_alarmCount--;
+
+    this->log_ACTIVITY_HI_AlarmRemoved(alarmId);
+    return status;
+}
+
 // ----------------------------------------------------------------------
 // Handler implementations for typed input ports
 // ----------------------------------------------------------------------
@@ -28,15 +431,98 @@ void TlmAlarm ::TlmRecv_handler(FwIndexType portNum, FwChanIdType id, Fw::Time&
     m_tlm.timeTag = timeTag;
     m_tlm.val = val;
 
+    // Cache the update if any alarm monitors this channel, evaluation happens on the alarm's tick
+    const U16 chanIdx = findChannel(id);
+    if (chanIdx != NO_INDEX) {
+        ChannelEntry& entry = m_channels[chanIdx];
+        const FwSizeType length = val.getBuffLength();
+        entry.length = static_cast<U8>((length < ChannelEntry::VALUE_BYTES) ? length : ChannelEntry::VALUE_BYTES);
+        std::memcpy(entry.value, val.getBuffAddr(), entry.length);
+        entry.seconds = timeTag.getSeconds();
+        entry.useconds = timeTag.getUSeconds();
+        entry.valid = true;
+    }
+
     // If a seq exists for this channel ID, lets try to call into it
 }
 
+void TlmAlarm ::TlmRecv_overflowHook(FwIndexType portNum, FwChanIdType id, Fw::Time& timeTag, Fw::TlmBuffer& val) {
+    // Called from whichever thread sent the update, so only count here and report from run
+    m_tlmDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
 Fw::ParamValid TlmAlarm ::paramMock_handler(FwIndexType portNum, FwPrmIdType id, Fw::ParamBuffer& val) {
     return Fw::ParamValid::VALID;
 }
 
 void TlmAlarm ::run_handler(FwIndexType portNum, U32 context) {
-    // TODO
+    FW_ASSERT(m_arena != nullptr);
+
+    // Process the queue of new tlm (and commands) before evaluating against it
+    while (this->doDispatch() == MSG_DISPATCH_OK) {
+    }
+    const U32 tlmDropped = m_tlmDropped.load(std::memory_order_relaxed);
+    if (tlmDropped != m_tlmDroppedReported) {
+        this->log_WARNING_LO_TlmDropped(tlmDropped);
+        m_tlmDroppedReported = tlmDropped;
+    }
+
+    if (context >= NUM_SCHED_GROUPS) {
+        this->log_WARNING_LO_UnknownSchedGroup(context);
+        return;
+    }
+
+    Os::RawTime start;
+    (void)start.now();
+
+    // An alarm of period p at phase f is due when tick % p == f, so each power of two period contributes
+    // exactly one slot per tick
+    const U32 tick = m_tick[context]++;
+    U32 evals = 0;
+    for (U16 period = 1; period <= MAX_PERIOD; period = static_cast<U16>(period << 1)) {
+        const U16 phase = static_cast<U16>(tick & (period - 1U));
+        for (U16 idx = m_slotHead[context * NUM_SCHED_SLOTS + slotIndex(period, phase)]; idx != NO_INDEX;
+             idx = m_alarms[idx].nextInSlot) {
+            m_due[evals++] = idx;
+        }
+    }
+
+    // Evaluation may run on several threads, reporting stays on this one and follows the due list so transitions
+    // come out in the same order whatever the number of workers
+    evaluateDue(evals);
+    for (U32 i = 0; i < evals; i++) {
+        if (m_results[i].state != m_alarms[m_due[i]].state) {
+            commitTransition(m_due[i], m_results[i]);
+        }
+    }
+
+    Os::RawTime end;
+    (void)end.now();
+    U32 tickTimeUsec = 0;
+    (void)end.getDiffUsec(start, tickTimeUsec);
+    // Groups run at different rates and load, so each keeps its own figures
+    m_tickEvals[context] = evals;
+    m_tickTimeUsec[context] = tickTimeUsec;
+    if (tickTimeUsec > m_maxTickTimeUsec[context]) {
+        m_maxTickTimeUsec[context] = tickTimeUsec;
+    }
+
+    // Send history in large batches, but don't let a quiet period hold records back indefinitely
+    m_ticksSinceFlush++;
+    if (m_historyCount >= m_historyFlushThreshold || (m_historyCount > 0 && m_ticksSinceFlush >= HISTORY_FLUSH_TICKS)) {
+        (void)flushHistory();
+    }
+
+    this->tlmWrite_TickEvals(m_tickEvals);
+    this->tlmWrite_TickTimeUsec(m_tickTimeUsec);
+    this->tlmWrite_MaxTickTimeUsec(m_maxTickTimeUsec);
+    this->tlmWrite_AlarmCount(m_alarmCount);
+    this->tlmWrite_TlmDropped(tlmDropped);
+    this->tlmWrite_HistoryPending(m_historyCount);
+    this->tlmWrite_HistoryOverwritten(m_historyOverwritten);
+    this->tlmWrite_HistoryDpsSent(m_historyDpsSent);
+    this->tlmWrite_ArenaBytesUsed(arenaBytesUsed());
+    this->tlmWrite_ArenaBytesReserved(m_arenaSize);
 }
 
 void TlmAlarm ::seqDoneIn_handler(FwIndexType portNum,
@@ -61,4 +547,254 @@ Fw::TlmValid TlmAlarm ::tlmMock_handler(FwIndexType portNum, FwChanIdType id, Fw
     return Fw::TlmValid::VALID;
 }
 
+// ----------------------------------------------------------------------
+// Handler implementations for commands
+// ----------------------------------------------------------------------
+
+void TlmAlarm ::ALARM_ADD_cmdHandler(FwOpcodeType opCode,
+                                     U32 cmdSeq,
+                                     U16 alarmId,
+                                     FwChanIdType chanId,
+                                     AlarmValueType valType,
+                                     F64 lowLimit,
+                                     F64 highLimit,
+                                     U8 schedGroup,
+                                     U16 period) {
+    const AlarmConfigStatus status = addAlarm(alarmId, chanId, valType, lowLimit, highLimit, schedGroup, period);
+    this->cmdResponse_out(opCode, cmdSeq,
+                          (status == AlarmConfigStatus::OK) ? Fw::CmdResponse::OK : Fw::CmdResponse::EXECUTION_ERROR);
+}
+
+void TlmAlarm ::ALARM_REMOVE_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U16 alarmId) {
+    const AlarmConfigStatus status = removeAlarm(alarmId);
+    this->cmdResponse_out(opCode, cmdSeq,
+                          (status == AlarmConfigStatus::OK) ? Fw::CmdResponse::OK : Fw::CmdResponse::EXECUTION_ERROR);
+}
+
+void TlmAlarm ::HISTORY_FLUSH_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) {
+    this->cmdResponse_out(opCode, cmdSeq, flushHistory() ? Fw::CmdResponse::OK : Fw::CmdResponse::EXECUTION_ERROR);
+}
+
+// ----------------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------------
+
+U16 TlmAlarm ::chanHash(FwChanIdType id) const {
+    // Fibonacci hashing, the top bits of the product are well mixed even for sequential IDs
+    return static_cast<U16>((static_cast<U32>(id) * 0x9E3779B1U) >> (32 - m_chanHashBits));
+}
+
+U16 TlmAlarm ::findChannel(FwChanIdType id) const {
+    for (U16 bucket = chanHash(id);; bucket = (bucket + 1) & m_chanHashMask) {
+        const U16 chanIdx = m_chanLookup[bucket];
+        if (chanIdx == NO_INDEX || m_channels[chanIdx].id == id) {
+            return chanIdx;
+        }
+    }
+}
+
+U16 TlmAlarm ::acquireChannel(FwChanIdType id) {
+    U16 chanIdx = findChannel(id);
+    if (chanIdx == NO_INDEX) {
+        for (U16 i = 0; i < m_maxChannels; i++) {
+            if (m_channels[i].refCount == 0) {
+                chanIdx = i;
+                break;
+            }
+        }
+        if (chanIdx == NO_INDEX) {
+            return NO_INDEX;
+        }
+
+        ChannelEntry& entry = m_channels[chanIdx];
+        entry.id = id;
+        entry.valid = false;
+        m_channelCount++;
+
+        U16 bucket = chanHash(id);
+        while (m_chanLookup[bucket] != NO_INDEX) {
+            bucket = (bucket + 1) & m_chanHashMask;
+        }
+        m_chanLookup[bucket] = chanIdx;
+    }
+    m_channels[chanIdx].refCount++;
+    return chanIdx;
+}
+
+void TlmAlarm ::releaseChannel(U16 chanIdx) {
+    ChannelEntry& entry = m_channels[chanIdx];
+    FW_ASSERT(entry.refCount > 0, chanIdx);
+    if (--entry.refCount > 0) {
+        return;
+    }
+    m_channelCount--;
+
+    // Backward shift deletion keeps every remaining entry reachable from its home bucket without tombstones
+    const U16 mask = m_chanHashMask;
+    U16 hole = chanHash(entry.id);
+    while (m_chanLookup[hole] != chanIdx) {
+        hole = (hole + 1) & mask;
+    }
+    for (U16 bucket = (hole + 1) & mask; m_chanLookup[bucket] != NO_INDEX; bucket = (bucket + 1) & mask) {
+        const U16 home = chanHash(m_channels[m_chanLookup[bucket]].id);
+        // Move the entry into the hole unless its home lies cyclically in (hole, bucket]
+        if (((bucket - home) & mask) >= ((bucket - hole) & mask)) {
+            m_chanLookup[hole] = m_chanLookup[bucket];
+            hole = bucket;
+        }
+    }
+    m_chanLookup[hole] = NO_INDEX;
+}
+
+U16 TlmAlarm ::pickPhase(U8 schedGroup, U16 period) const {
+    // Minimize the busiest tick the alarm would land on, then the total load on its ticks
+    U16 bestPhase = 0;
+    U32 bestPeak = 0;
+    U32 bestSum = 0;
+    for (U16 phase = 0; phase < period; phase++) {
+        U32 peak = 0;
+        U32 sum = 0;
+        for (U16 tick = phase; tick < MAX_PERIOD; tick = static_cast<U16>(tick + period)) {
+            const U32 load = m_phaseLoad[schedGroup * MAX_PERIOD + tick];
+            peak = (load > peak) ? load : peak;
+            sum += load;
+        }
+        if (phase == 0 || peak < bestPeak || (peak == bestPeak && sum < bestSum)) {
+            bestPhase = phase;
+            bestPeak = peak;
+            bestSum = sum;
+        }
+    }
+    return bestPhase;
+}
+
+void TlmAlarm ::adjustLoad(const AlarmSchedule& sched, I32 delta) {
+    U32* load = &m_phaseLoad[sched.schedGroup * MAX_PERIOD];
+    for (U16 tick = sched.phase; tick < MAX_PERIOD; tick = static_cast<U16>(tick + sched.period)) {
+        load[tick] = static_cast<U32>(static_cast<I32>(load[tick]) + delta);
+    }
+}
+
+void TlmAlarm ::evaluateDue(U32 count) {
+    const U32 numChunks = (count + CHUNK_ALARMS - 1) / CHUNK_ALARMS;
+    if (m_numWorkers == 0 || numChunks < 2) {
+        evaluateRange(0, count);
+        return;
+    }
+
+    // Give every participant an even, contiguous share of the chunks, threads that finish early steal the rest
+    const U32 participants = m_numWorkers + 1;
+    m_dueCount = count;
+    for (U32 p = 0; p < participants; p++) {
+        m_cursors[p].next.store(numChunks * p / participants, std::memory_order_relaxed);
+        m_cursors[p].end = numChunks * (p + 1) / participants;
+    }
+
+    m_poolMutex.lock();
+    m_busyWorkers = m_numWorkers;
+    m_generation++;
+    m_poolMutex.unlock();
+    m_workReady.notifyAll();
+
+    evaluateChunks(0);
+
+    // Join: the results are complete and visible to this thread once every worker has checked in
+    m_poolMutex.lock();
+    while (m_busyWorkers > 0) {
+        m_workDone.wait(m_poolMutex);
+    }
+    m_poolMutex.unlock();
+}
+
+void TlmAlarm ::evaluateChunks(U32 self) {
+    const U32 participants = m_numWorkers + 1;
+    for (U32 k = 0; k < participants; k++) {
+        ChunkCursor& cursor = m_cursors[(self + k) % participants];
+        for (U32 chunk = cursor.next.fetch_add(1, std::memory_order_relaxed); chunk < cursor.end;
+             chunk = cursor.next.fetch_add(1, std::memory_order_relaxed)) {
+            const U32 first = chunk * CHUNK_ALARMS;
+            evaluateRange(first, (first + CHUNK_ALARMS < m_dueCount) ? first + CHUNK_ALARMS : m_dueCount);
+        }
+    }
+}
+
+void TlmAlarm ::evaluateRange(U32 first, U32 last) const {
+    for (U32 i = first; i < last; i++) {
+        const AlarmEntry& alarm = m_alarms[m_due[i]];
+        const ChannelEntry& chan = m_channels[alarm.chanIdx];
+        EvalResult& result = m_results[i];
+        result.state = alarm.state;
+        if (!chan.valid || !decodeValue(chan.value, chan.length, alarm.valType, result.value)) {
+            continue;
+        }
+
+        if (result.value < alarm.lowLimit) {
+            result.state = AlarmState::LOW;
+        } else if (result.value > alarm.highLimit) {
+            result.state = AlarmState::HIGH;
+        } else {
+            result.state = AlarmState::NOMINAL;
+        }
+    }
+}
+
+void TlmAlarm ::commitTransition(U16 alarmIdx, const EvalResult& result) {
+    AlarmEntry& alarm = m_alarms[alarmIdx];
+    const ChannelEntry& chan = m_channels[alarm.chanIdx];
+    this->log_ACTIVITY_HI_AlarmTransition(alarmIdx, chan.id, alarm.state, result.state, result.value);
+    recordTransition(alarmIdx, chan, result.value, alarm.state, result.state);
+    alarm.state = result.state;
+}
+
+void TlmAlarm ::recordTransition(U16 alarmId,
+                                 const ChannelEntry& chan,
+                                 F64 value,
+                                 AlarmState::T oldState,
+                                 AlarmState::T newState) {
+    U32 slot = m_historyHead + m_historyCount;
+    if (slot >= m_historyDepth) {
+        slot -= m_historyDepth;
+    }
+    if (m_historyCount == m_historyDepth) {
+        // Keep the most recent history: the new record takes the oldest one's place
+        m_historyHead = (m_historyHead + 1 == m_historyDepth) ? 0 : m_historyHead + 1;
+        m_historyOverwritten++;
+    } else {
+        m_historyCount++;
+    }
+    m_history[slot].set(alarmId, chan.id, chan.seconds, chan.useconds, value, oldState, newState);
+}
+
+bool TlmAlarm ::flushHistory() {
+    m_ticksSinceFlush = 0;
+    if (m_historyCount == 0) {
+        return true;
+    }
+
+    // A wrapped ring is written as two array records, both oldest first
+    const FwSizeType recordHeader = sizeof(FwDpIdType) + sizeof(FwSizeStoreType);
+    const FwSizeType dataSize = 2 * recordHeader + m_historyCount * AlarmTransitionRecord::SERIALIZED_SIZE;
+    DpContainer container;
+    if (!this->isConnected_productGetOut_OutputPort(0) ||
+        this->dpGet_AlarmHistory(dataSize, container) != Fw::Success::SUCCESS) {
+        this->log_WARNING_LO_HistoryDpFailed(m_historyCount);
+        return false;
+    }
+
+    const U32 firstCount =
+        (m_historyHead + m_historyCount <= m_historyDepth) ? m_historyCount : m_historyDepth - m_historyHead;
+    Fw::SerializeStatus status = container.serializeRecord_Transitions(&m_history[m_historyHead], firstCount);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    if (firstCount < m_historyCount) {
+        status = container.serializeRecord_Transitions(&m_history[0], m_historyCount - firstCount);
+        FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    }
+    this->dpSend(container);
+
+    m_historyHead = 0;
+    m_historyCount = 0;
+    m_historyDpsSent++;
+    return true;
+}
+
 }  // namespace FprimeTlmAlarm
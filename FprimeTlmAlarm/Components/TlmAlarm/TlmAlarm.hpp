@@ -8,6 +8,12 @@
 #define FprimeTlmAlarm_TlmAlarm_HPP
 
 #include "FprimeTlmAlarm/Components/TlmAlarm/TlmAlarmComponentAc.hpp"
+#include "Fw/Types/MemAllocator.hpp"
+#include "Os/Condition.hpp"
+#include "Os/Mutex.hpp"
+#include "Os/Task.hpp"
+
+#include <atomic>
 
 namespace FprimeTlmAlarm {
 
@@ -18,8 +24,68 @@ struct TlmStruct {
     Fw::TlmBuffer val;  //!< Buffer containing serialized telemetry value
 };
 
+//! Latest update of a channel monitored by at least one alarm
+//!
+//! Only the leading bytes an alarm can decode are kept, so an entry stays a fixed 24 bytes
+struct ChannelEntry {
+    static constexpr U8 VALUE_BYTES = 8;  //!< Widest value encoding an alarm decodes
+
+    FwChanIdType id;        //!< Channel ID
+    U32 seconds;            //!< Time tag seconds of the latest update
+    U32 useconds;           //!< Time tag microseconds of the latest update
+    U16 refCount;           //!< Number of alarms monitoring this channel, 0 when the entry is free
+    U8 length;              //!< Value bytes held, at most VALUE_BYTES
+    bool valid;             //!< True once an update has been received
+    U8 value[VALUE_BYTES];  //!< Leading bytes of the serialized value
+};
+
+//! Alarm fields read on every evaluation, kept together so a tick walks densely packed entries
+struct AlarmEntry {
+    F64 lowLimit;               //!< Values below this are LOW
+    F64 highLimit;              //!< Values above this are HIGH
+    U16 chanIdx;                //!< Index of the monitored channel in the channel cache
+    U16 nextInSlot;             //!< Next alarm in the same schedule slot
+    AlarmValueType::T valType;  //!< Encoding of the channel value
+    AlarmState::T state;        //!< Last evaluated state
+};
+
+//! Outcome of evaluating one due alarm, written by whichever thread evaluated it
+struct EvalResult {
+    F64 value;            //!< Decoded channel value
+    AlarmState::T state;  //!< State the value puts the alarm in, unchanged when there was nothing to decode
+};
+
+//! Alarm fields only touched when alarms are added or removed
+struct AlarmSchedule {
+    U16 period;     //!< Evaluation period in ticks
+    U16 phase;      //!< Tick within the period the alarm is evaluated on
+    U8 schedGroup;  //!< Scheduling group the alarm belongs to
+    bool inUse;     //!< True when the slot holds a registered alarm
+};
+
 class TlmAlarm final : public TlmAlarmComponentBase {
   public:
+    // ----------------------------------------------------------------------
+    // Constants
+    // ----------------------------------------------------------------------
+
+    static constexpr U16 MAX_PERIOD = 64;               //!< Longest evaluation period in ticks, a power of two
+    static constexpr U8 NUM_SCHED_GROUPS = 4;           //!< Number of run contexts the component schedules for
+    static constexpr U16 NO_INDEX = 0xFFFF;             //!< Sentinel for empty table links
+    static constexpr U16 MAX_CHANNELS_LIMIT = 0x4000;   //!< Largest channel cache configure accepts
+    static constexpr U32 HISTORY_FLUSH_TICKS = 60;      //!< run calls after which any pending records are sent
+    static constexpr FwSizeType CACHE_LINE_BYTES = 64;  //!< Alignment of every table in the arena
+    static constexpr U32 CHUNK_ALARMS = 64;             //!< Due alarms handed to a thread at a time
+    static constexpr U8 MAX_WORKERS = 7;                //!< Largest worker pool, the run thread also evaluates
+    static_assert(SchedGroupU32::SIZE == NUM_SCHED_GROUPS, "Tick telemetry must have one entry per scheduling group");
+    static_assert(SchedGroupUsec::SIZE == NUM_SCHED_GROUPS, "Tick telemetry must have one entry per scheduling group");
+    //! One slot per (period, phase) pair: 1 + 2 + 4 + ... + MAX_PERIOD
+    static constexpr U16 NUM_SCHED_SLOTS = 2 * MAX_PERIOD - 1;
+
+    static_assert((MAX_PERIOD & (MAX_PERIOD - 1)) == 0, "MAX_PERIOD must be a power of two");
+    static_assert(2 * MAX_CHANNELS_LIMIT <= NO_INDEX, "Channel lookup buckets must fit in a U16");
+    static_assert((CHUNK_ALARMS * sizeof(U16)) % CACHE_LINE_BYTES == 0, "Chunks must not share cache lines");
+
     // ----------------------------------------------------------------------
     // Component construction and destruction
     // ----------------------------------------------------------------------
@@ -31,6 +97,71 @@ class TlmAlarm final : public TlmAlarmComponentBase {
     //! Destroy TlmAlarm object
     ~TlmAlarm();
 
+    // ----------------------------------------------------------------------
+    // Memory
+    // ----------------------------------------------------------------------
+
+    //! Bytes configure requests from the allocator for the given table sizes
+    //!
+    //! Lets a deployment compute the component's footprint ahead of time.
+    static FwSizeType arenaSize(U16 maxAlarms,    //!< Alarm table size, alarm IDs run from 0 to maxAlarms - 1
+                                U16 maxChannels,  //!< Distinct channels the alarms may monitor
+                                U32 historyDepth  //!< Transition records held between data products
+    );
+
+    //! Allocate every table from one arena and reset them
+    //!
+    //! Must be called once before the component is run. Sizes out of range or a short allocation assert.
+    void configure(FwEnumStoreType memId,        //!< Memory segment identifier passed to the allocator
+                   Fw::MemAllocator& allocator,  //!< Allocator supplying the arena
+                   U16 maxAlarms,                //!< Alarm table size, alarm IDs run from 0 to maxAlarms - 1
+                   U16 maxChannels,              //!< Distinct channels the alarms may monitor
+                   U32 historyDepth              //!< Transition records held between data products
+    );
+
+    //! Return the arena to the allocator it came from
+    void cleanup(Fw::MemAllocator& allocator  //!< Allocator passed to configure
+    );
+
+    // ----------------------------------------------------------------------
+    // Parallel evaluation
+    // ----------------------------------------------------------------------
+
+    //! Start a pool of threads that share each tick's alarm evaluation with the run thread
+    //!
+    //! Optional, without workers every alarm is evaluated on the run thread. Call after configure and before the
+    //! component is run. Transitions are reported in the same order whatever the number of workers.
+    void startWorkers(U8 numWorkers,  //!< Threads to start, at most MAX_WORKERS, 0 to evaluate serially
+                      FwTaskPriorityType priority = Os::Task::TASK_PRIORITY_DEFAULT,  //!< Worker priority
+                      FwSizeType stackSize = Os::Task::TASK_DEFAULT                   //!< Worker stack size
+    );
+
+    //! Stop and join the worker pool
+    void stopWorkers();
+
+    // ----------------------------------------------------------------------
+    // Alarm table
+    // ----------------------------------------------------------------------
+
+    //! Register a limit alarm and assign it the least loaded phase within its period
+    //!
+    //! Backs the ALARM_ADD command and may be called from topology setup to preload alarms.
+    //! \return OK on success, otherwise the reason the alarm was rejected
+    AlarmConfigStatus addAlarm(U16 alarmId,                     //!< Alarm table slot to populate
+                               FwChanIdType chanId,             //!< Channel to monitor
+                               const AlarmValueType& valType,   //!< Encoding of the channel value
+                               F64 lowLimit,                    //!< Values below this are LOW
+                               F64 highLimit,                   //!< Values above this are HIGH
+                               U8 schedGroup,                   //!< Scheduling group (run context)
+                               U16 period                       //!< Evaluation period in ticks
+    );
+
+    //! Remove a registered alarm
+    //!
+    //! \return OK on success, otherwise the reason the request was rejected
+    AlarmConfigStatus removeAlarm(U16 alarmId  //!< Alarm table slot to clear
+    );
+
   private:
     // ----------------------------------------------------------------------
     // Handler implementations for typed input ports
@@ -43,6 +174,15 @@ class TlmAlarm final : public TlmAlarmComponentBase {
                          Fw::TlmBuffer& val    //!< Buffer containing serialized telemetry value
                          ) override;
 
+    //! Overflow hook implementation for TlmRecv
+    //!
+    //! Runs on the sending thread when the queue is full, the update is dropped and counted
+    void TlmRecv_overflowHook(FwIndexType portNum,  //!< The port number
+                              FwChanIdType id,      //!< Telemetry Channel ID
+                              Fw::Time& timeTag,    //!< Time Tag
+                              Fw::TlmBuffer& val    //!< Buffer containing serialized telemetry value
+                              ) override;
+
     //! Handler implementation for paramMock
     //!
     //! port for feeding channel comparison seq thresholds and receiving debounce/persistence
@@ -54,7 +194,8 @@ class TlmAlarm final : public TlmAlarmComponentBase {
 
     //! Handler implementation for run
     //!
-    //! Example port: receiving calls from the rate group
+    //! Drains queued telemetry and evaluates the alarms scheduled this tick.
+    //! The context selects the scheduling group, so the port may be driven by several rate groups.
     void run_handler(FwIndexType portNum,  //!< The port number
                      U32 context           //!< The call order
                      ) override;
@@ -85,9 +226,180 @@ class TlmAlarm final : public TlmAlarmComponentBase {
                                                        //!< Size set to 0 if channel not found, or if no value
                                                        //!< has been received for this channel yet.
                                  ) override;
+
+  private:
+    // ----------------------------------------------------------------------
+    // Handler implementations for commands
+    // ----------------------------------------------------------------------
+
+    //! Handler implementation for command ALARM_ADD
+    //!
+    //! Register a limit alarm on a telemetry channel
+    void ALARM_ADD_cmdHandler(FwOpcodeType opCode,    //!< The opcode
+                              U32 cmdSeq,             //!< The command sequence number
+                              U16 alarmId,            //!< Alarm table slot to populate
+                              FwChanIdType chanId,    //!< Channel to monitor
+                              AlarmValueType valType, //!< Encoding of the channel value
+                              F64 lowLimit,           //!< Values below this limit are LOW
+                              F64 highLimit,          //!< Values above this limit are HIGH
+                              U8 schedGroup,          //!< Scheduling group, matched against the run port context
+                              U16 period              //!< Evaluation period in ticks, a power of two
+                              ) override;
+
+    //! Handler implementation for command ALARM_REMOVE
+    //!
+    //! Remove a limit alarm
+    void ALARM_REMOVE_cmdHandler(FwOpcodeType opCode,  //!< The opcode
+                                 U32 cmdSeq,           //!< The command sequence number
+                                 U16 alarmId           //!< Alarm table slot to clear
+                                 ) override;
+
+    //! Handler implementation for command HISTORY_FLUSH
+    //!
+    //! Send the pending alarm history as a data product now
+    void HISTORY_FLUSH_cmdHandler(FwOpcodeType opCode,  //!< The opcode
+                                  U32 cmdSeq            //!< The command sequence number
+                                  ) override;
+
+    // ----------------------------------------------------------------------
+    // Helpers
+    // ----------------------------------------------------------------------
+
+    //! A worker thread of the evaluation pool
+    struct Worker {
+        TlmAlarm* component;  //!< Component the worker evaluates for
+        U32 index;            //!< Participant index, the run thread is 0
+        U32 generation;       //!< Generation of the pool when the worker started
+        Os::Task task;        //!< Thread running workerLoop
+    };
+
+    //! Range of due list chunks assigned to one participant of a tick, other participants steal from its front
+    struct alignas(CACHE_LINE_BYTES) ChunkCursor {
+        std::atomic<U32> next;  //!< Next chunk to take
+        U32 end;                //!< One past the last chunk of the range
+    };
+
+    //! Byte offsets of the tables within the arena, each starting on a cache line
+    struct ArenaLayout {
+        FwSizeType alarms;      //!< AlarmEntry table
+        FwSizeType schedules;   //!< AlarmSchedule table
+        FwSizeType channels;    //!< ChannelEntry table
+        FwSizeType due;         //!< Alarms due this tick, in evaluation order
+        FwSizeType results;     //!< EvalResult of each due alarm
+        FwSizeType chanLookup;  //!< Channel lookup buckets
+        FwSizeType slotHead;    //!< Schedule slot heads of every group
+        FwSizeType phaseLoad;   //!< Per-tick load of every group
+        FwSizeType history;     //!< Transition history ring
+        FwSizeType size;        //!< Total bytes
+        U8 chanHashBits;        //!< log2 of the channel lookup size
+    };
+
+    //! Place the tables for the given sizes
+    static ArenaLayout arenaLayout(U16 maxAlarms, U16 maxChannels, U32 historyDepth);
+
+    //! Bytes of the arena holding live state
+    FwSizeType arenaBytesUsed() const;
+
+    //! Index of the schedule slot holding alarms of a given period and phase
+    static U16 slotIndex(U16 period, U16 phase) { return static_cast<U16>(period - 1 + phase); }
+
+    //! Home bucket of a channel in the channel lookup table
+    U16 chanHash(FwChanIdType id) const;
+
+    //! Look up the channel cache index of a channel, NO_INDEX if it is not cached
+    U16 findChannel(FwChanIdType id) const;
+
+    //! Find or create the channel cache entry for a channel and take a reference on it
+    U16 acquireChannel(FwChanIdType id);
+
+    //! Drop a reference on a channel cache entry, freeing it when unused
+    void releaseChannel(U16 chanIdx);
+
+    //! Pick the phase that keeps the peak per-tick load of a scheduling group lowest
+    U16 pickPhase(U8 schedGroup, U16 period) const;
+
+    //! Add or subtract an alarm's contribution to its group's per-tick load
+    void adjustLoad(const AlarmSchedule& sched, I32 delta);
+
+    //! Evaluate the due alarms, spread across the worker pool when it is running
+    void evaluateDue(U32 count);
+
+    //! Evaluate chunks of the due list until none are left, starting with a thread's own share
+    void evaluateChunks(U32 self);
+
+    //! Compare due alarms [first, last) against their limits, writing only their results
+    void evaluateRange(U32 first, U32 last) const;
+
+    //! Report an alarm's state change
+    void commitTransition(U16 alarmIdx, const EvalResult& result);
+
+    //! Entry point of a worker thread
+    static void workerRoutine(void* arg);
+
+    //! Wait for ticks and evaluate chunks until the pool is stopped
+    void workerLoop(U32 self, U32 generation);
+
+    //! Append a transition to the history ring, overwriting the oldest record when full
+    void recordTransition(U16 alarmId,
+                          const ChannelEntry& chan,
+                          F64 value,
+                          AlarmState::T oldState,
+                          AlarmState::T newState);
+
+    //! Send the pending history as one data product
+    //!
+    //! \return true if the history was sent or nothing was pending
+    bool flushHistory();
+
     // Member vars
   private:
     TlmStruct m_tlm;  //!< Struct Storing the current Tlm Update we are processing
+
+    // Tables carved from the arena by configure
+    void* m_arena;                     //!< Allocation backing every table, nullptr until configured
+    FwEnumStoreType m_memId;           //!< Memory segment identifier of the arena
+    FwSizeType m_arenaSize;            //!< Bytes reserved for the arena
+    AlarmEntry* m_alarms;              //!< Evaluation state of each alarm, indexed by alarm ID
+    AlarmSchedule* m_schedules;        //!< Scheduling state of each alarm, indexed by alarm ID
+    ChannelEntry* m_channels;          //!< Latest value of every monitored channel
+    U16* m_chanLookup;                 //!< Open addressed channel ID -> channel cache index
+    U16* m_slotHead;                   //!< First alarm of each schedule slot, NUM_SCHED_SLOTS per group
+    U32* m_phaseLoad;                  //!< Alarms evaluated on each tick of the longest period, MAX_PERIOD per group
+    AlarmTransitionRecord* m_history;  //!< Ring of transitions not yet sent
+    U16* m_due;                        //!< Alarms due this tick, in evaluation order
+    EvalResult* m_results;             //!< Result of each due alarm
+    U16 m_maxAlarms;                   //!< Alarm table size
+    U16 m_maxChannels;                 //!< Channel cache size
+    U16 m_chanHashMask;                //!< Channel lookup size - 1, the size is a power of two
+    U8 m_chanHashBits;                 //!< log2 of the channel lookup size
+    U32 m_historyDepth;                //!< History ring size
+    U32 m_historyFlushThreshold;       //!< Pending records that trigger a data product
+
+    U32 m_tick[NUM_SCHED_GROUPS];      //!< Ticks seen by each scheduling group
+    U32 m_alarmCount;                  //!< Number of registered alarms
+    U32 m_channelCount;                //!< Number of cached channels
+    SchedGroupU32 m_tickEvals;         //!< Alarms evaluated on the last tick of each scheduling group
+    SchedGroupUsec m_tickTimeUsec;     //!< Evaluation time of the last tick of each scheduling group
+    SchedGroupUsec m_maxTickTimeUsec;  //!< Largest per-tick evaluation time of each scheduling group
+    std::atomic<U32> m_tlmDropped;     //!< Updates dropped on a full queue, written by the sending threads
+    U32 m_tlmDroppedReported;          //!< Value of m_tlmDropped when the last drop event was sent
+    U32 m_historyHead;                 //!< Index of the oldest pending record
+    U32 m_historyCount;                //!< Number of pending records
+    U32 m_historyOverwritten;          //!< Records lost to a full ring
+    U32 m_historyDpsSent;              //!< Data products sent
+    U32 m_ticksSinceFlush;             //!< run calls since the history was last sent
+
+    // Evaluation pool
+    Worker m_workers[MAX_WORKERS];           //!< Evaluation pool
+    ChunkCursor m_cursors[MAX_WORKERS + 1];  //!< Chunk range of each participant, the run thread first
+    U32 m_numWorkers;                        //!< Running workers
+    U32 m_dueCount;                          //!< Alarms due in the tick being evaluated
+    Os::Mutex m_poolMutex;                   //!< Protects the pool state below
+    Os::ConditionVariable m_workReady;       //!< Signaled when a tick is ready or the pool stops
+    Os::ConditionVariable m_workDone;        //!< Signaled when the last worker finishes a tick
+    U32 m_generation;                        //!< Ticks handed to the pool
+    U32 m_busyWorkers;                       //!< Workers still evaluating the current tick
+    bool m_stopping;                         //!< Set to make the workers exit
 };
 
 }  // namespace FprimeTlmAlarm
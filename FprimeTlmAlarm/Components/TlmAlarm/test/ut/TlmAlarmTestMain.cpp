@@ -0,0 +1,57 @@
+// ======================================================================
+// \title  TlmAlarmTestMain.cpp
+// \author wmac
+// \brief  cpp file for TlmAlarm component test main function
+// ======================================================================
+
+#include "TlmAlarmTester.hpp"
+
+TEST(Nominal, transitions) {
+    FprimeTlmAlarm::TlmAlarmTester tester;
+    tester.transitions();
+}
+
+TEST(Nominal, spreadsLoad) {
+    FprimeTlmAlarm::TlmAlarmTester tester;
+    tester.spreadsLoad();
+}
+
+TEST(Nominal, schedGroups) {
+    FprimeTlmAlarm::TlmAlarmTester tester;
+    tester.schedGroups();
+}
+
+TEST(OffNominal, rejectsBadConfig) {
+    FprimeTlmAlarm::TlmAlarmTester tester;
+    tester.rejectsBadConfig();
+}
+
+TEST(OffNominal, dropsOnFullQueue) {
+    FprimeTlmAlarm::TlmAlarmTester tester;
+    tester.dropsOnFullQueue();
+}
+
+TEST(Nominal, arenaAccounting) {
+    FprimeTlmAlarm::TlmAlarmTester tester;
+    tester.arenaAccounting();
+}
+
+TEST(Nominal, parallelMatchesSerial) {
+    FprimeTlmAlarm::TlmAlarmTester tester;
+    tester.parallelMatchesSerial();
+}
+
+TEST(Nominal, historyFlush) {
+    FprimeTlmAlarm::TlmAlarmTester tester;
+    tester.historyFlush();
+}
+
+TEST(OffNominal, historyWraps) {
+    FprimeTlmAlarm::TlmAlarmTester tester;
+    tester.historyWraps();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
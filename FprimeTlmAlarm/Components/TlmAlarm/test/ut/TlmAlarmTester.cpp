@@ -0,0 +1,390 @@
+// ======================================================================
+// \title  TlmAlarmTester.cpp
+// \author wmac
+// \brief  cpp file for TlmAlarm component test harness implementation class
+// ======================================================================
+
+#include "TlmAlarmTester.hpp"
+
+namespace FprimeTlmAlarm {
+
+// ----------------------------------------------------------------------
+// Construction and destruction
+// ----------------------------------------------------------------------
+
+TlmAlarmTester ::TlmAlarmTester()
+    : TlmAlarmGTestBase("TlmAlarmTester", TlmAlarmTester::MAX_HISTORY_SIZE),
+      component("TlmAlarm"),
+      dpAvailable(false),
+      dpStorage() {
+    this->initComponents();
+    this->connectPorts();
+    this->component.configure(0, this->allocator, TEST_MAX_ALARMS, TEST_MAX_CHANNELS, TEST_HISTORY_DEPTH);
+}
+
+TlmAlarmTester ::~TlmAlarmTester() {
+    this->component.cleanup(this->allocator);
+}
+
+// ----------------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------------
+
+void TlmAlarmTester ::transitions() {
+    const FwChanIdType ID = 0x1700;
+
+    ASSERT_EQ(AlarmConfigStatus::OK, component.addAlarm(0, ID, AlarmValueType::UINT32, 0.0, 10.0, 0, 1));
+
+    // No data yet, nothing to report
+    invoke_to_run(0, 0);
+    ASSERT_EVENTS_AlarmTransition_SIZE(0);
+
+    sendU32(ID, 20);
+    invoke_to_run(0, 0);
+    ASSERT_EVENTS_AlarmTransition_SIZE(1);
+    ASSERT_EVENTS_AlarmTransition(0, 0, ID, AlarmState::NO_DATA, AlarmState::HIGH, 20.0);
+
+    // Staying out of limits is not a transition
+    sendU32(ID, 30);
+    invoke_to_run(0, 0);
+    ASSERT_EVENTS_AlarmTransition_SIZE(1);
+
+    sendU32(ID, 5);
+    invoke_to_run(0, 0);
+    ASSERT_EVENTS_AlarmTransition_SIZE(2);
+    ASSERT_EVENTS_AlarmTransition(1, 0, ID, AlarmState::HIGH, AlarmState::NOMINAL, 5.0);
+
+    // Updates to unmonitored channels are ignored
+    sendU32(ID + 1, 50);
+    invoke_to_run(0, 0);
+    ASSERT_EVENTS_AlarmTransition_SIZE(2);
+}
+
+void TlmAlarmTester ::spreadsLoad() {
+    const FwChanIdType ID = 0x1700;
+    const U16 PERIOD = 4;
+    const U16 PER_PHASE = 2;
+
+    for (U16 alarm = 0; alarm < PERIOD * PER_PHASE; alarm++) {
+        ASSERT_EQ(AlarmConfigStatus::OK,
+                  component.addAlarm(alarm, ID + alarm, AlarmValueType::UINT32, 0.0, 10.0, 0, PERIOD));
+        ASSERT_EVENTS_AlarmAdded(alarm, alarm, ID + alarm, 0, PERIOD, alarm % PERIOD);
+    }
+    // An every-tick alarm lands on top of every phase
+    ASSERT_EQ(AlarmConfigStatus::OK,
+              component.addAlarm(PERIOD * PER_PHASE, ID, AlarmValueType::UINT32, 0.0, 10.0, 0, 1));
+
+    for (U16 tick = 0; tick < 2 * PERIOD; tick++) {
+        invoke_to_run(0, 0);
+        ASSERT_EQ(PER_PHASE + 1U, tlmHistory_TickEvals->at(tick).arg[0]);
+        ASSERT_TLM_AlarmCount(tick, PERIOD * PER_PHASE + 1);
+    }
+
+    // Freed phases are refilled first
+    ASSERT_EQ(AlarmConfigStatus::OK, component.removeAlarm(2));
+    ASSERT_EQ(AlarmConfigStatus::OK, component.removeAlarm(6));
+    this->clearHistory();
+    ASSERT_EQ(AlarmConfigStatus::OK, component.addAlarm(2, ID, AlarmValueType::UINT32, 0.0, 10.0, 0, PERIOD));
+    ASSERT_EVENTS_AlarmAdded(0, 2, ID, 0, PERIOD, 2);
+}
+
+void TlmAlarmTester ::schedGroups() {
+    const FwChanIdType ID = 0x1700;
+
+    ASSERT_EQ(AlarmConfigStatus::OK, component.addAlarm(0, ID, AlarmValueType::UINT32, 0.0, 10.0, 1, 1));
+    sendU32(ID, 20);
+
+    invoke_to_run(0, 0);
+    ASSERT_TLM_TickEvals_SIZE(1);
+    ASSERT_EQ(0U, tlmHistory_TickEvals->at(0).arg[0]);
+    ASSERT_EVENTS_AlarmTransition_SIZE(0);
+
+    // Each group reports its own tick figures, the other groups keep theirs
+    invoke_to_run(0, 1);
+    ASSERT_EQ(0U, tlmHistory_TickEvals->at(1).arg[0]);
+    ASSERT_EQ(1U, tlmHistory_TickEvals->at(1).arg[1]);
+    ASSERT_EVENTS_AlarmTransition_SIZE(1);
+    invoke_to_run(0, 0);
+    ASSERT_EQ(0U, tlmHistory_TickEvals->at(2).arg[0]);
+    ASSERT_EQ(1U, tlmHistory_TickEvals->at(2).arg[1]);
+
+    invoke_to_run(0, TlmAlarm::NUM_SCHED_GROUPS);
+    ASSERT_EVENTS_UnknownSchedGroup_SIZE(1);
+    ASSERT_EVENTS_UnknownSchedGroup(0, TlmAlarm::NUM_SCHED_GROUPS);
+}
+
+void TlmAlarmTester ::rejectsBadConfig() {
+    const FwChanIdType ID = 0x1700;
+    const U32 CMD_SEQ = 42;
+
+    sendCmd_ALARM_ADD(0, CMD_SEQ, 0, ID, AlarmValueType::UINT32, 0.0, 10.0, 0, 3);
+    sendCmd_ALARM_ADD(0, CMD_SEQ, 0, ID, AlarmValueType::UINT32, 10.0, 0.0, 0, 1);
+    sendCmd_ALARM_ADD(0, CMD_SEQ, 0, ID, AlarmValueType::UINT32, 0.0, 10.0, TlmAlarm::NUM_SCHED_GROUPS, 1);
+    sendCmd_ALARM_ADD(0, CMD_SEQ, TEST_MAX_ALARMS, ID, AlarmValueType::UINT32, 0.0, 10.0, 0, 1);
+    sendCmd_ALARM_ADD(0, CMD_SEQ, 0, ID, AlarmValueType::UINT32, 0.0, 10.0, 0, 1);
+    sendCmd_ALARM_ADD(0, CMD_SEQ, 0, ID, AlarmValueType::UINT32, 0.0, 10.0, 0, 1);
+    sendCmd_ALARM_REMOVE(0, CMD_SEQ, 1);
+    invoke_to_run(0, 0);
+
+    ASSERT_CMD_RESPONSE_SIZE(7);
+    ASSERT_CMD_RESPONSE(0, TlmAlarm::OPCODE_ALARM_ADD, CMD_SEQ, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_CMD_RESPONSE(4, TlmAlarm::OPCODE_ALARM_ADD, CMD_SEQ, Fw::CmdResponse::OK);
+    ASSERT_CMD_RESPONSE(5, TlmAlarm::OPCODE_ALARM_ADD, CMD_SEQ, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_CMD_RESPONSE(6, TlmAlarm::OPCODE_ALARM_REMOVE, CMD_SEQ, Fw::CmdResponse::EXECUTION_ERROR);
+
+    ASSERT_EVENTS_AlarmConfigFailed_SIZE(6);
+    ASSERT_EVENTS_AlarmConfigFailed(0, 0, AlarmConfigStatus::INVALID_PERIOD);
+    ASSERT_EVENTS_AlarmConfigFailed(1, 0, AlarmConfigStatus::INVALID_LIMITS);
+    ASSERT_EVENTS_AlarmConfigFailed(2, 0, AlarmConfigStatus::INVALID_GROUP);
+    ASSERT_EVENTS_AlarmConfigFailed(3, TEST_MAX_ALARMS, AlarmConfigStatus::INVALID_ID);
+    ASSERT_EVENTS_AlarmConfigFailed(4, 0, AlarmConfigStatus::ID_IN_USE);
+    ASSERT_EVENTS_AlarmConfigFailed(5, 1, AlarmConfigStatus::NOT_IN_USE);
+    ASSERT_TLM_AlarmCount(0, 1);
+}
+
+void TlmAlarmTester ::dropsOnFullQueue() {
+    const FwChanIdType ID = 0x1700;
+    const U32 EXTRA = 3;
+
+    ASSERT_EQ(AlarmConfigStatus::OK, component.addAlarm(0, ID, AlarmValueType::UINT32, 0.0, 10.0, 0, 1));
+    for (U32 i = 0; i < TEST_INSTANCE_QUEUE_DEPTH + EXTRA; i++) {
+        sendU32(ID, 5);
+    }
+    // Dropped, so the alarm sees the last queued update rather than the high value
+    sendU32(ID, 20);
+    invoke_to_run(0, 0);
+    ASSERT_EVENTS_TlmDropped_SIZE(1);
+    ASSERT_EVENTS_TlmDropped(0, EXTRA + 1);
+    ASSERT_TLM_TlmDropped(0, EXTRA + 1);
+    ASSERT_EVENTS_AlarmTransition_SIZE(1);
+    ASSERT_EVENTS_AlarmTransition(0, 0, ID, AlarmState::NO_DATA, AlarmState::NOMINAL, 5.0);
+
+    // No new drops, no new event
+    sendU32(ID, 5);
+    invoke_to_run(0, 0);
+    ASSERT_EVENTS_TlmDropped_SIZE(1);
+    ASSERT_TLM_TlmDropped(1, EXTRA + 1);
+}
+
+void TlmAlarmTester ::arenaAccounting() {
+    const FwChanIdType ID = 0x1700;
+    const FwSizeType RESERVED = TlmAlarm::arenaSize(TEST_MAX_ALARMS, TEST_MAX_CHANNELS, TEST_HISTORY_DEPTH);
+
+    invoke_to_run(0, 0);
+    ASSERT_TLM_ArenaBytesReserved(0, RESERVED);
+    ASSERT_TLM_ArenaBytesUsed_SIZE(1);
+    const FwSizeType idle = this->tlmHistory_ArenaBytesUsed->at(0).arg;
+    ASSERT_LT(idle, RESERVED);
+
+    // Two alarms sharing a channel take one channel entry between them
+    ASSERT_EQ(AlarmConfigStatus::OK, component.addAlarm(0, ID, AlarmValueType::UINT32, 0.0, 10.0, 0, 1));
+    ASSERT_EQ(AlarmConfigStatus::OK, component.addAlarm(1, ID, AlarmValueType::UINT32, 0.0, 20.0, 0, 1));
+    invoke_to_run(0, 0);
+    ASSERT_TLM_ArenaBytesUsed(1, idle + 2 * (sizeof(AlarmEntry) + sizeof(AlarmSchedule)) + sizeof(ChannelEntry));
+
+    ASSERT_EQ(AlarmConfigStatus::OK, component.removeAlarm(0));
+    ASSERT_EQ(AlarmConfigStatus::OK, component.removeAlarm(1));
+    invoke_to_run(0, 0);
+    ASSERT_TLM_ArenaBytesUsed(2, idle);
+}
+
+void TlmAlarmTester ::parallelMatchesSerial() {
+    TlmAlarmTester serial;
+    serial.driveWorkload();
+
+    component.startWorkers(TEST_WORKERS);
+    this->driveWorkload();
+    component.stopWorkers();
+
+    const FwSizeType expectedSize = serial.eventHistory_AlarmTransition->size();
+    ASSERT_GT(expectedSize, 0U);
+    ASSERT_EVENTS_AlarmTransition_SIZE(expectedSize);
+    for (FwSizeType i = 0; i < expectedSize; i++) {
+        const EventEntry_AlarmTransition& expected = serial.eventHistory_AlarmTransition->at(i);
+        ASSERT_EVENTS_AlarmTransition(i, expected.alarmId, expected.chanId, expected.oldState, expected.newState,
+                                      expected.value);
+    }
+}
+
+void TlmAlarmTester ::historyFlush() {
+    const U32 CMD_SEQ = 42;
+    const U32 TRANSITIONS = 3;
+
+    // Nothing pending is not an error and does not ask for a buffer
+    sendCmd_HISTORY_FLUSH(0, CMD_SEQ);
+    invoke_to_run(0, 0);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, TlmAlarm::OPCODE_HISTORY_FLUSH, CMD_SEQ, Fw::CmdResponse::OK);
+    ASSERT_PRODUCT_GET_SIZE(0);
+
+    // Fewer records than the flush threshold stay pending until commanded
+    driveTransitions(100, TRANSITIONS);
+    ASSERT_PRODUCT_GET_SIZE(0);
+    this->clearHistory();
+
+    sendCmd_HISTORY_FLUSH(0, CMD_SEQ);
+    invoke_to_run(0, 0);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, TlmAlarm::OPCODE_HISTORY_FLUSH, CMD_SEQ, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_HistoryDpFailed_SIZE(1);
+    ASSERT_EVENTS_HistoryDpFailed(0, TRANSITIONS);
+    ASSERT_PRODUCT_GET_SIZE(1);
+    ASSERT_PRODUCT_SEND_SIZE(0);
+    ASSERT_TLM_HistoryPending(0, TRANSITIONS);
+    this->clearHistory();
+
+    // The records survive a failed flush and go out with the next one
+    this->dpAvailable = true;
+    sendCmd_HISTORY_FLUSH(0, CMD_SEQ);
+    invoke_to_run(0, 0);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, TlmAlarm::OPCODE_HISTORY_FLUSH, CMD_SEQ, Fw::CmdResponse::OK);
+    ASSERT_PRODUCT_GET_SIZE(1);
+    ASSERT_EQ(component.getIdBase() + TlmAlarm::ContainerId::AlarmHistory, productGetHistory->at(0).id);
+    ASSERT_PRODUCT_SEND_SIZE(1);
+    ASSERT_TLM_HistoryPending(0, 0);
+    ASSERT_TLM_HistoryDpsSent(0, 1);
+
+    std::vector<AlarmTransitionRecord> records;
+    const std::vector<FwSizeType> batches = readHistory(0, records);
+    ASSERT_EQ(1U, batches.size());
+    ASSERT_EQ(TRANSITIONS, records.size());
+    for (U32 i = 0; i < TRANSITIONS; i++) {
+        ASSERT_EQ(100 + i, records[i].get_seconds());
+    }
+    ASSERT_EQ(AlarmState::NO_DATA, records[0].get_oldState());
+    ASSERT_EQ(AlarmState::HIGH, records[0].get_newState());
+    ASSERT_EQ(20.0, records[0].get_value());
+}
+
+void TlmAlarmTester ::historyWraps() {
+    const U32 CMD_SEQ = 42;
+    const U32 EXTRA = 8;
+    const U32 DEPTH = TEST_HISTORY_DEPTH;
+
+    // Without buffers the threshold flushes fail, so the ring fills and then overwrites its oldest records
+    driveTransitions(0, DEPTH + EXTRA);
+    ASSERT_TLM_HistoryPending(DEPTH + EXTRA - 1, DEPTH);
+    ASSERT_TLM_HistoryOverwritten(DEPTH + EXTRA - 1, EXTRA);
+    ASSERT_PRODUCT_SEND_SIZE(0);
+    this->clearHistory();
+
+    this->dpAvailable = true;
+    sendCmd_HISTORY_FLUSH(0, CMD_SEQ);
+    invoke_to_run(0, 0);
+    ASSERT_CMD_RESPONSE(0, TlmAlarm::OPCODE_HISTORY_FLUSH, CMD_SEQ, Fw::CmdResponse::OK);
+    ASSERT_PRODUCT_SEND_SIZE(1);
+
+    // The ring wrapped, so the records come out as the tail of the ring then its start
+    std::vector<AlarmTransitionRecord> records;
+    const std::vector<FwSizeType> batches = readHistory(0, records);
+    ASSERT_EQ(2U, batches.size());
+    ASSERT_EQ(DEPTH - EXTRA, batches[0]);
+    ASSERT_EQ(EXTRA, batches[1]);
+    ASSERT_EQ(DEPTH, records.size());
+    for (U32 i = 0; i < DEPTH; i++) {
+        ASSERT_EQ(EXTRA + i, records[i].get_seconds());
+    }
+}
+
+// ----------------------------------------------------------------------
+// Handlers for data product ports
+// ----------------------------------------------------------------------
+
+Fw::Success::T TlmAlarmTester ::productGet_handler(FwDpIdType id, FwSizeType dataSize, Fw::Buffer& buffer) {
+    this->pushProductGetEntry(id, dataSize);
+    if (!this->dpAvailable) {
+        return Fw::Success::FAILURE;
+    }
+    // No slack, so a data size that undercounts the records trips the component's serialize asserts
+    const FwSizeType size = Fw::DpContainer::getPacketSizeForDataSize(dataSize);
+    EXPECT_LE(size, sizeof(this->dpStorage));
+    if (size > sizeof(this->dpStorage)) {
+        return Fw::Success::FAILURE;
+    }
+    buffer = Fw::Buffer(this->dpStorage, size);
+    return Fw::Success::SUCCESS;
+}
+
+// ----------------------------------------------------------------------
+// Helper methods
+// ----------------------------------------------------------------------
+
+void TlmAlarmTester ::sendU32(FwChanIdType id, U32 value, U32 seconds) {
+    U8 buf[4] = {static_cast<U8>(value >> 24), static_cast<U8>(value >> 16), static_cast<U8>(value >> 8),
+                 static_cast<U8>(value)};
+    Fw::TlmBuffer tlm(buf, sizeof(buf));
+    Fw::Time time(seconds, 7171);
+    invoke_to_TlmRecv(0, id, time, tlm);
+}
+
+void TlmAlarmTester ::driveTransitions(U32 first, U32 count) {
+    const FwChanIdType ID = 0x1700;
+
+    ASSERT_EQ(AlarmConfigStatus::OK, component.addAlarm(0, ID, AlarmValueType::UINT32, 0.0, 10.0, 0, 1));
+    for (U32 i = 0; i < count; i++) {
+        // Alternate above and within the limits so every tick changes state
+        sendU32(ID, (i % 2 == 0) ? 20 : 5, first + i);
+        invoke_to_run(0, 0);
+    }
+    ASSERT_EVENTS_AlarmTransition_SIZE(count);
+}
+
+std::vector<FwSizeType> TlmAlarmTester ::readHistory(FwSizeType index, std::vector<AlarmTransitionRecord>& records) {
+    std::vector<FwSizeType> batches;
+    records.clear();
+
+    const Fw::Buffer buffer = productSendHistory->at(index).buffer;
+    Fw::DpContainer container;
+    container.setBuffer(buffer);
+    EXPECT_EQ(Fw::FW_SERIALIZE_OK, container.deserializeHeader());
+    EXPECT_EQ(component.getIdBase() + TlmAlarm::ContainerId::AlarmHistory, container.getId());
+
+    // The component must have asked for at least as much data as it wrote
+    const FwSizeType dataSize = container.getDataSize();
+    EXPECT_LE(dataSize, productGetHistory->at(index).size);
+    Fw::ExternalSerializeBuffer data(buffer.getData() + Fw::DpContainer::DATA_OFFSET, dataSize);
+    EXPECT_EQ(Fw::FW_SERIALIZE_OK, data.setBuffLen(dataSize));
+
+    FwSizeType consumed = 0;
+    while (consumed < dataSize) {
+        FwDpIdType recordId = 0;
+        FwSizeStoreType size = 0;
+        EXPECT_EQ(Fw::FW_SERIALIZE_OK, data.deserializeTo(recordId));
+        EXPECT_EQ(Fw::FW_SERIALIZE_OK, data.deserializeTo(size));
+        EXPECT_EQ(component.getIdBase() + TlmAlarm::RecordId::Transitions, recordId);
+        for (FwSizeStoreType i = 0; i < size; i++) {
+            AlarmTransitionRecord record;
+            EXPECT_EQ(Fw::FW_SERIALIZE_OK, data.deserializeTo(record));
+            records.push_back(record);
+        }
+        batches.push_back(size);
+        consumed += sizeof(FwDpIdType) + sizeof(FwSizeStoreType) + size * AlarmTransitionRecord::SERIALIZED_SIZE;
+    }
+    EXPECT_EQ(dataSize, consumed);
+    return batches;
+}
+
+void TlmAlarmTester ::driveWorkload() {
+    const FwChanIdType ID = 0x1700;
+    const U32 TICKS = 4;
+
+    // Alarms share channels and mix periods and limits, so each tick has several chunks of due alarms and transitions
+    // in every direction
+    for (U16 alarm = 0; alarm < TEST_MAX_ALARMS; alarm++) {
+        const F64 low = static_cast<F64>(alarm % 11);
+        ASSERT_EQ(AlarmConfigStatus::OK,
+                  component.addAlarm(alarm, ID + alarm % TEST_MAX_CHANNELS, AlarmValueType::UINT32, low,
+                                     low + static_cast<F64>(alarm % 5), 0, static_cast<U16>(1U << (alarm % 3))));
+    }
+    this->clearHistory();
+
+    for (U32 tick = 0; tick < TICKS; tick++) {
+        for (U16 chan = 0; chan < TEST_MAX_CHANNELS; chan++) {
+            sendU32(ID + chan, (tick * 7 + chan * 3) % 17);
+        }
+        invoke_to_run(0, 0);
+    }
+}
+
+}  // namespace FprimeTlmAlarm
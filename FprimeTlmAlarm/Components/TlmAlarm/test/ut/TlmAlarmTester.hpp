@@ -0,0 +1,139 @@
+// ======================================================================
+// \title  TlmAlarmTester.hpp
+// \author wmac
+// \brief  hpp file for TlmAlarm component test harness implementation class
+// ======================================================================
+
+#ifndef FprimeTlmAlarm_TlmAlarmTester_HPP
+#define FprimeTlmAlarm_TlmAlarmTester_HPP
+
+#include "FprimeTlmAlarm/Components/TlmAlarm/TlmAlarm.hpp"
+#include "FprimeTlmAlarm/Components/TlmAlarm/TlmAlarmGTestBase.hpp"
+#include "Fw/Dp/DpContainer.hpp"
+#include "Fw/Types/MallocAllocator.hpp"
+
+#include <vector>
+
+namespace FprimeTlmAlarm {
+
+class TlmAlarmTester final : public TlmAlarmGTestBase {
+  public:
+    // ----------------------------------------------------------------------
+    // Constants
+    // ----------------------------------------------------------------------
+
+    // Maximum size of histories storing events, telemetry, and port outputs
+    static const FwSizeType MAX_HISTORY_SIZE = 1024;
+
+    // Instance ID supplied to the component instance under test
+    static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+    // Queue depth supplied to the component instance under test
+    static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 16;
+
+    // Table sizes the component under test is configured with
+    static const U16 TEST_MAX_ALARMS = 256;
+    static const U16 TEST_MAX_CHANNELS = 12;
+    static const U32 TEST_HISTORY_DEPTH = 32;
+
+    // Worker threads used when evaluating in parallel
+    static const U8 TEST_WORKERS = 3;
+
+    // Storage for the data product buffers handed to the component under test
+    static const FwSizeType DP_STORAGE_SIZE = 4096;
+
+  public:
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct object TlmAlarmTester
+    TlmAlarmTester();
+
+    //! Destroy object TlmAlarmTester
+    ~TlmAlarmTester();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    //! Alarms report state changes as their channel crosses the limits
+    void transitions();
+
+    //! Alarms sharing a period are spread across its phases
+    void spreadsLoad();
+
+    //! The run context selects which alarms are evaluated
+    void schedGroups();
+
+    //! Invalid alarm configurations are rejected
+    void rejectsBadConfig();
+
+    //! Updates arriving on a full queue are dropped and counted
+    void dropsOnFullQueue();
+
+    //! Arena usage follows the registered alarms within the reserved size
+    void arenaAccounting();
+
+    //! Evaluating with worker threads reports the same transitions, in the same order, as evaluating serially
+    void parallelMatchesSerial();
+
+    //! HISTORY_FLUSH sends pending transitions oldest first and reports when no buffer is available
+    void historyFlush();
+
+    //! A wrapped history ring keeps the newest transitions and is sent as two records
+    void historyWraps();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Handlers for data product ports
+    // ----------------------------------------------------------------------
+
+    //! Hand out a buffer sized exactly for the requested data when dpAvailable is set
+    Fw::Success::T productGet_handler(FwDpIdType id, FwSizeType dataSize, Fw::Buffer& buffer) override;
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper functions
+    // ----------------------------------------------------------------------
+
+    //! Connect ports
+    void connectPorts();
+
+    //! Initialize components
+    void initComponents();
+
+    //! Send a big-endian U32 channel update to the component
+    void sendU32(FwChanIdType id, U32 value, U32 seconds = 1717);
+
+    //! Drive one alarm through a transition per tick, the update of tick i carrying time tag seconds first + i
+    void driveTransitions(U32 first, U32 count);
+
+    //! Decode the alarm history product at index in the send history, returning the size of each Transitions record
+    std::vector<FwSizeType> readHistory(FwSizeType index, std::vector<AlarmTransitionRecord>& records);
+
+    //! Fill the alarm table and run a few ticks of updates that drive many transitions
+    void driveWorkload();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Member variables
+    // ----------------------------------------------------------------------
+
+    //! Allocator backing the component's tables
+    Fw::MallocAllocator allocator;
+
+    //! The component under test
+    TlmAlarm component;
+
+    //! Whether productGet_handler hands out a buffer
+    bool dpAvailable;
+
+    //! Backing memory of the data product buffers
+    U8 dpStorage[DP_STORAGE_SIZE];
+};
+
+}  // namespace FprimeTlmAlarm
+
+#endif
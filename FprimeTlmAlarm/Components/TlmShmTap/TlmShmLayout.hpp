@@ -0,0 +1,85 @@
+// ======================================================================
+// \title  TlmShmLayout.hpp
+// \author wmac
+// \brief  Layout of the shared-memory last-value telemetry table
+//
+// Shared between the TlmShmTap writer and out-of-process readers, so this
+// header only depends on the C++ standard library.
+// ======================================================================
+
+#ifndef FprimeTlmAlarm_TlmShmLayout_HPP
+#define FprimeTlmAlarm_TlmShmLayout_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace FprimeTlmAlarm {
+namespace TlmShm {
+
+constexpr uint32_t MAGIC = 0x544C4D53;  //!< "TLMS", written last once the table is initialized
+constexpr uint32_t VERSION = 1;         //!< Bumped on any layout change
+constexpr size_t CACHE_LINE = 64;       //!< Slots are padded to whole cache lines
+
+// ATOMIC_INT_LOCK_FREE rather than is_always_lock_free so out-of-process tools can build as C++11
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "Shared-memory atomics must be lock free");
+
+//! Segment header, followed by slotCount slots of slotStride bytes each
+struct alignas(CACHE_LINE) Header {
+    std::atomic<uint32_t> magic;         //!< MAGIC once the writer has initialized the table
+    uint32_t version;                    //!< VERSION of the writer
+    uint32_t slotCount;                  //!< Number of slots, a power of two
+    uint32_t slotStride;                 //!< Bytes between consecutive slots
+    uint32_t valueCapacity;              //!< Bytes reserved for the serialized value in each slot
+    std::atomic<uint32_t> channelCount;  //!< Slots claimed by a channel
+};
+
+//! Per-channel slot. The serialized value (valueCapacity bytes) immediately follows the struct.
+//!
+//! chanId is written once before claimed is set. The remaining fields are protected by seq: the writer makes seq odd,
+//! updates the fields, then makes seq even again. Readers retry if seq was odd or changed across their copy.
+struct alignas(CACHE_LINE) Slot {
+    std::atomic<uint32_t> claimed;  //!< Non-zero once chanId is valid
+    uint32_t chanId;                //!< Channel stored in this slot
+    std::atomic<uint32_t> seq;      //!< Seqlock sequence, odd while an update is in progress
+    uint32_t seconds;               //!< Time tag seconds
+    uint32_t useconds;              //!< Time tag microseconds
+    uint16_t timeBase;              //!< Time tag base
+    uint8_t timeContext;            //!< Time tag context
+    uint8_t reserved;               //!< Padding
+    uint32_t length;                //!< Serialized value length in bytes
+};
+
+//! Bytes between consecutive slots for a given value capacity
+constexpr uint32_t slotStride(uint32_t valueCapacity) {
+    return static_cast<uint32_t>((sizeof(Slot) + valueCapacity + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE);
+}
+
+//! Total segment size for a given table geometry
+constexpr size_t segmentSize(uint32_t slotCount, uint32_t valueCapacity) {
+    return sizeof(Header) + static_cast<size_t>(slotCount) * slotStride(valueCapacity);
+}
+
+//! Home slot of a channel. Slots are open addressed with linear probing so readers can find a channel directly.
+inline uint32_t homeSlot(uint32_t chanId, uint32_t slotCount) {
+    uint32_t hash = chanId * 0x9E3779B1U;
+    hash ^= hash >> 16;
+    return hash & (slotCount - 1);
+}
+
+//! Slot at an index within a mapped segment
+inline Slot* slotAt(void* base, uint32_t index) {
+    Header* header = static_cast<Header*>(base);
+    return reinterpret_cast<Slot*>(reinterpret_cast<uint8_t*>(base) + sizeof(Header) +
+                                   static_cast<size_t>(index) * header->slotStride);
+}
+
+//! Serialized value bytes of a slot
+inline uint8_t* slotValue(Slot* slot) {
+    return reinterpret_cast<uint8_t*>(slot) + sizeof(Slot);
+}
+
+}  // namespace TlmShm
+}  // namespace FprimeTlmAlarm
+
+#endif
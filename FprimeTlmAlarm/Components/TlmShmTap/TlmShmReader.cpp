@@ -0,0 +1,140 @@
+// ======================================================================
+// \title  TlmShmReader.cpp
+// \author wmac
+// \brief  Reader library for the shared-memory last-value telemetry table
+// ======================================================================
+
+#include "FprimeTlmAlarm/Components/TlmShmTap/TlmShmReader.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+
+namespace FprimeTlmAlarm {
+
+TlmShmReader ::TlmShmReader() : m_base(nullptr), m_size(0) {}
+
+TlmShmReader ::~TlmShmReader() {
+    this->close();
+}
+
+TlmShmReader::Status TlmShmReader ::open(const char* name) {
+    this->close();
+
+    const int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        return OPEN_FAILED;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        (void)::close(fd);
+        return OPEN_FAILED;
+    }
+    // The writer creates the name before sizing the segment
+    if (static_cast<size_t>(info.st_size) < sizeof(TlmShm::Header)) {
+        (void)::close(fd);
+        return NOT_READY;
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+    void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    (void)::close(fd);
+    if (base == MAP_FAILED) {
+        return OPEN_FAILED;
+    }
+
+    const TlmShm::Header* header = static_cast<const TlmShm::Header*>(base);
+    Status status = OK;
+    if (header->magic.load(std::memory_order_acquire) != TlmShm::MAGIC) {
+        status = NOT_READY;
+    } else if (header->version != TlmShm::VERSION ||
+               TlmShm::segmentSize(header->slotCount, header->valueCapacity) > size) {
+        status = BAD_VERSION;
+    }
+    if (status != OK) {
+        (void)munmap(base, size);
+        return status;
+    }
+
+    m_base = base;
+    m_size = size;
+    return OK;
+}
+
+void TlmShmReader ::close() {
+    if (m_base != nullptr) {
+        (void)munmap(m_base, m_size);
+        m_base = nullptr;
+        m_size = 0;
+    }
+}
+
+TlmShmReader::Handle TlmShmReader ::find(uint32_t chanId) const {
+    if (m_base == nullptr) {
+        return nullptr;
+    }
+    const TlmShm::Header* header = static_cast<const TlmShm::Header*>(m_base);
+    const uint32_t mask = header->slotCount - 1;
+    // The writer keeps the table at most half full, so an unclaimed slot always ends the probe
+    for (uint32_t index = TlmShm::homeSlot(chanId, header->slotCount);; index = (index + 1) & mask) {
+        const TlmShm::Slot* slot = TlmShm::slotAt(m_base, index);
+        if (slot->claimed.load(std::memory_order_acquire) == 0) {
+            return nullptr;
+        }
+        if (slot->chanId == chanId) {
+            return slot;
+        }
+    }
+}
+
+TlmShmReader::Status TlmShmReader ::read(Handle handle, Sample& sample, uint8_t* value, uint32_t capacity) const {
+    if (m_base == nullptr) {
+        return NOT_OPEN;
+    }
+    if (handle == nullptr) {
+        return NOT_FOUND;
+    }
+    TlmShm::Slot* slot = const_cast<TlmShm::Slot*>(handle);
+
+    for (uint32_t attempt = 0; attempt < MAX_RETRIES; attempt++) {
+        const uint32_t before = slot->seq.load(std::memory_order_acquire);
+        if ((before & 1U) != 0) {
+            continue;
+        }
+        sample.chanId = slot->chanId;
+        sample.seconds = slot->seconds;
+        sample.useconds = slot->useconds;
+        sample.timeBase = slot->timeBase;
+        sample.timeContext = slot->timeContext;
+        sample.length = slot->length;
+        sample.updates = before >> 1;
+        const uint32_t length = (sample.length <= capacity) ? sample.length : capacity;
+        (void)std::memcpy(value, TlmShm::slotValue(slot), length);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) == before) {
+            return (sample.length <= capacity) ? OK : TOO_SMALL;
+        }
+    }
+    return BUSY;
+}
+
+uint32_t TlmShmReader ::updates(Handle handle) const {
+    // Odd sequences are in-flight updates, each completed update advances the sequence by two
+    return handle->seq.load(std::memory_order_acquire) >> 1;
+}
+
+uint32_t TlmShmReader ::slotCount() const {
+    return (m_base == nullptr) ? 0 : static_cast<const TlmShm::Header*>(m_base)->slotCount;
+}
+
+TlmShmReader::Handle TlmShmReader ::slotHandle(uint32_t index) const {
+    if (index >= this->slotCount()) {
+        return nullptr;
+    }
+    const TlmShm::Slot* slot = TlmShm::slotAt(m_base, index);
+    return (slot->claimed.load(std::memory_order_acquire) != 0) ? slot : nullptr;
+}
+
+}  // namespace FprimeTlmAlarm
@@ -0,0 +1,88 @@
+// ======================================================================
+// \title  TlmShmReader.hpp
+// \author wmac
+// \brief  Reader library for the shared-memory last-value telemetry table
+//
+// Intended for diagnostic tools on the same host as the flight software.
+// Depends only on the C++ standard library and POSIX shared memory.
+// ======================================================================
+
+#ifndef FprimeTlmAlarm_TlmShmReader_HPP
+#define FprimeTlmAlarm_TlmShmReader_HPP
+
+#include "FprimeTlmAlarm/Components/TlmShmTap/TlmShmLayout.hpp"
+
+namespace FprimeTlmAlarm {
+
+//! Maps a TlmShmTap segment read only and copies out consistent channel values
+//!
+//! Readers never write to the segment and never block the writer. A read that races an update is retried.
+class TlmShmReader {
+  public:
+    //! Result of reader operations
+    enum Status {
+        OK,           //!< Sample copied
+        NOT_OPEN,     //!< No segment is mapped
+        OPEN_FAILED,  //!< shm_open, fstat or mmap failed
+        NOT_READY,    //!< Segment exists but the writer has not finished initializing it
+        BAD_VERSION,  //!< Segment was written by an incompatible layout version
+        NOT_FOUND,    //!< Channel has not been published
+        BUSY,         //!< Writer kept updating the slot through every retry
+        TOO_SMALL,    //!< Caller value buffer is smaller than the published value
+    };
+
+    //! Metadata of a published value
+    struct Sample {
+        uint32_t chanId;       //!< Channel ID
+        uint32_t seconds;      //!< Time tag seconds
+        uint32_t useconds;     //!< Time tag microseconds
+        uint16_t timeBase;     //!< Time tag base
+        uint8_t timeContext;   //!< Time tag context
+        uint32_t length;       //!< Serialized value length in bytes
+        uint32_t updates;      //!< Updates completed on the slot when copied, wraps
+    };
+
+    //! Opaque reference to a channel slot, valid until close()
+    typedef const TlmShm::Slot* Handle;
+
+    //! Attempts made by read() before returning BUSY
+    static constexpr uint32_t MAX_RETRIES = 1000;
+
+    TlmShmReader();
+    ~TlmShmReader();
+
+    //! Map the named segment read only
+    Status open(const char* name);
+
+    //! Unmap the segment
+    void close();
+
+    //! Locate a channel. Lookups probe the table, so pollers should keep the handle.
+    //!
+    //! \return nullptr if the channel has not been published yet
+    Handle find(uint32_t chanId) const;
+
+    //! Copy out a consistent value of a channel
+    Status read(Handle handle,       //!< Slot returned by find()
+                Sample& sample,      //!< Metadata of the value
+                uint8_t* value,      //!< Buffer for the serialized value
+                uint32_t capacity    //!< Size of the value buffer
+    ) const;
+
+    //! Cheap change detection: the slot's update counter, without copying the value
+    uint32_t updates(Handle handle) const;
+
+    //! Number of slots in the table, for enumeration with slotHandle()
+    uint32_t slotCount() const;
+
+    //! Handle of a slot by index, nullptr if the slot is unclaimed
+    Handle slotHandle(uint32_t index) const;
+
+  private:
+    void* m_base;   //!< Mapped segment, nullptr when closed
+    size_t m_size;  //!< Mapped size in bytes
+};
+
+}  // namespace FprimeTlmAlarm
+
+#endif
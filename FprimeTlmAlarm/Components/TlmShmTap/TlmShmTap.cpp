@@ -0,0 +1,49 @@
+// ======================================================================
+// \title  TlmShmTap.cpp
+// \author wmac
+// \brief  cpp file for TlmShmTap component implementation class
+// ======================================================================
+
+#include "FprimeTlmAlarm/Components/TlmShmTap/TlmShmTap.hpp"
+#include "Fw/Types/String.hpp"
+
+namespace FprimeTlmAlarm {
+
+// ----------------------------------------------------------------------
+// Component construction and destruction
+// ----------------------------------------------------------------------
+
+TlmShmTap ::TlmShmTap(const char* const compName) : TlmShmTapComponentBase(compName) {}
+
+TlmShmTap ::~TlmShmTap() {}
+
+bool TlmShmTap ::configure(const char* name, U32 maxChannels) {
+    const Fw::String nameStr(name);
+    if (m_writer.open(name, maxChannels, FW_TLM_BUFFER_MAX_SIZE) != TlmShmWriter::OK) {
+        this->log_WARNING_HI_ShmOpenFailed(nameStr, m_writer.getErrno());
+        return false;
+    }
+    this->log_ACTIVITY_LO_ShmOpened(nameStr, maxChannels);
+    return true;
+}
+
+void TlmShmTap ::cleanup() {
+    m_writer.close(true);
+}
+
+// ----------------------------------------------------------------------
+// Handler implementations for typed input ports
+// ----------------------------------------------------------------------
+
+void TlmShmTap ::TlmRecv_handler(FwIndexType portNum, FwChanIdType id, Fw::Time& timeTag, Fw::TlmBuffer& val) {
+    // Guarded port: every component thread writing telemetry funnels through here, and the table has one writer
+    const TlmShmWriter::Status status =
+        m_writer.publish(id, timeTag.getSeconds(), timeTag.getUSeconds(), static_cast<U16>(timeTag.getTimeBase()),
+                         static_cast<U8>(timeTag.getContext()), val.getBuffAddr(),
+                         static_cast<U32>(val.getBuffLength()));
+    if (status == TlmShmWriter::TABLE_FULL) {
+        this->log_WARNING_LO_TableFull(id);
+    }
+}
+
+}  // namespace FprimeTlmAlarm
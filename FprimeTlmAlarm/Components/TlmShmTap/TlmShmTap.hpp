@@ -0,0 +1,59 @@
+// ======================================================================
+// \title  TlmShmTap.hpp
+// \author wmac
+// \brief  hpp file for TlmShmTap component implementation class
+// ======================================================================
+
+#ifndef FprimeTlmAlarm_TlmShmTap_HPP
+#define FprimeTlmAlarm_TlmShmTap_HPP
+
+#include "FprimeTlmAlarm/Components/TlmShmTap/TlmShmTapComponentAc.hpp"
+#include "FprimeTlmAlarm/Components/TlmShmTap/TlmShmWriter.hpp"
+
+namespace FprimeTlmAlarm {
+
+class TlmShmTap final : public TlmShmTapComponentBase {
+  public:
+    // ----------------------------------------------------------------------
+    // Component construction and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct TlmShmTap object
+    TlmShmTap(const char* const compName  //!< The component name
+    );
+
+    //! Destroy TlmShmTap object
+    ~TlmShmTap();
+
+    //! Create the shared-memory segment. Updates are dropped until this succeeds.
+    //!
+    //! \return true if the segment was created
+    bool configure(const char* name,   //!< Segment name, e.g. "/AlarmedTelem.tlm"
+                   U32 maxChannels     //!< Number of distinct channels the table holds
+    );
+
+    //! Unmap and remove the shared-memory segment
+    void cleanup();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Handler implementations for typed input ports
+    // ----------------------------------------------------------------------
+
+    //! Handler implementation for TlmRecv
+    //!
+    //! Recv Telemetry Stream
+    void TlmRecv_handler(FwIndexType portNum,  //!< The port number
+                         FwChanIdType id,      //!< Telemetry Channel ID
+                         Fw::Time& timeTag,    //!< Time Tag
+                         Fw::TlmBuffer& val    //!< Buffer containing serialized telemetry value
+                         ) override;
+
+    // Member vars
+  private:
+    TlmShmWriter m_writer;  //!< Owner of the shared-memory table
+};
+
+}  // namespace FprimeTlmAlarm
+
+#endif
@@ -0,0 +1,138 @@
+// ======================================================================
+// \title  TlmShmWriter.cpp
+// \author wmac
+// \brief  cpp file for the shared-memory last-value telemetry table writer
+// ======================================================================
+
+#include "FprimeTlmAlarm/Components/TlmShmTap/TlmShmWriter.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace FprimeTlmAlarm {
+
+TlmShmWriter ::TlmShmWriter() : m_base(nullptr), m_size(0), m_maxClaims(0), m_name(), m_errno(0) {}
+
+TlmShmWriter ::~TlmShmWriter() {
+    this->close(false);
+}
+
+TlmShmWriter::Status TlmShmWriter ::open(const char* name, uint32_t maxChannels, uint32_t valueCapacity) {
+    this->close(false);
+
+    // Keep the open addressed table at most half full so probes stay short for writer and readers
+    uint32_t slotCount = 1;
+    while (slotCount < 2 * maxChannels) {
+        slotCount <<= 1;
+    }
+    const size_t size = TlmShm::segmentSize(slotCount, valueCapacity);
+
+    // Start from a fresh segment so stale readers of a previous run see it disappear
+    (void)shm_unlink(name);
+    const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        m_errno = errno;
+        return OPEN_FAILED;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        m_errno = errno;
+        (void)::close(fd);
+        (void)shm_unlink(name);
+        return OPEN_FAILED;
+    }
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)::close(fd);
+    if (base == MAP_FAILED) {
+        m_errno = errno;
+        (void)shm_unlink(name);
+        return OPEN_FAILED;
+    }
+
+    // ftruncate zero fills, so every slot starts unclaimed with an even sequence
+    TlmShm::Header* header = static_cast<TlmShm::Header*>(base);
+    header->version = TlmShm::VERSION;
+    header->slotCount = slotCount;
+    header->slotStride = TlmShm::slotStride(valueCapacity);
+    header->valueCapacity = valueCapacity;
+    header->channelCount.store(0, std::memory_order_relaxed);
+    header->magic.store(TlmShm::MAGIC, std::memory_order_release);
+
+    m_base = base;
+    m_size = size;
+    m_maxClaims = slotCount / 2;
+    (void)std::strncpy(m_name, name, sizeof(m_name) - 1);
+    m_name[sizeof(m_name) - 1] = '\0';
+    return OK;
+}
+
+void TlmShmWriter ::close(bool unlinkName) {
+    if (m_base == nullptr) {
+        return;
+    }
+    (void)munmap(m_base, m_size);
+    if (unlinkName) {
+        (void)shm_unlink(m_name);
+    }
+    m_base = nullptr;
+    m_size = 0;
+}
+
+TlmShm::Slot* TlmShmWriter ::lookup(uint32_t chanId) {
+    TlmShm::Header* header = static_cast<TlmShm::Header*>(m_base);
+    const uint32_t mask = header->slotCount - 1;
+    for (uint32_t index = TlmShm::homeSlot(chanId, header->slotCount);; index = (index + 1) & mask) {
+        TlmShm::Slot* slot = TlmShm::slotAt(m_base, index);
+        // Only this writer claims slots, so a relaxed load of our own stores is enough
+        if (slot->claimed.load(std::memory_order_relaxed) == 0) {
+            const uint32_t claims = header->channelCount.load(std::memory_order_relaxed);
+            if (claims >= m_maxClaims) {
+                return nullptr;
+            }
+            slot->chanId = chanId;
+            slot->claimed.store(1, std::memory_order_release);
+            header->channelCount.store(claims + 1, std::memory_order_release);
+            return slot;
+        }
+        if (slot->chanId == chanId) {
+            return slot;
+        }
+    }
+}
+
+TlmShmWriter::Status TlmShmWriter ::publish(uint32_t chanId,
+                                            uint32_t seconds,
+                                            uint32_t useconds,
+                                            uint16_t timeBase,
+                                            uint8_t timeContext,
+                                            const uint8_t* value,
+                                            uint32_t length) {
+    if (m_base == nullptr) {
+        return NOT_OPEN;
+    }
+    if (length > static_cast<TlmShm::Header*>(m_base)->valueCapacity) {
+        return TOO_LARGE;
+    }
+    TlmShm::Slot* slot = this->lookup(chanId);
+    if (slot == nullptr) {
+        return TABLE_FULL;
+    }
+
+    const uint32_t seq = slot->seq.load(std::memory_order_relaxed);
+    slot->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->seconds = seconds;
+    slot->useconds = useconds;
+    slot->timeBase = timeBase;
+    slot->timeContext = timeContext;
+    slot->length = length;
+    (void)std::memcpy(TlmShm::slotValue(slot), value, length);
+
+    slot->seq.store(seq + 2, std::memory_order_release);
+    return OK;
+}
+
+}  // namespace FprimeTlmAlarm
@@ -0,0 +1,67 @@
+// ======================================================================
+// \title  TlmShmWriter.hpp
+// \author wmac
+// \brief  hpp file for the shared-memory last-value telemetry table writer
+// ======================================================================
+
+#ifndef FprimeTlmAlarm_TlmShmWriter_HPP
+#define FprimeTlmAlarm_TlmShmWriter_HPP
+
+#include "FprimeTlmAlarm/Components/TlmShmTap/TlmShmLayout.hpp"
+
+namespace FprimeTlmAlarm {
+
+//! Creates a POSIX shared-memory segment and publishes last values into it
+//!
+//! A writer is single threaded: callers must serialize publish() themselves.
+class TlmShmWriter {
+  public:
+    //! Result of writer operations
+    enum Status {
+        OK,           //!< Operation succeeded
+        NOT_OPEN,     //!< No segment is mapped
+        OPEN_FAILED,  //!< shm_open, ftruncate or mmap failed, see the saved errno
+        TABLE_FULL,   //!< No free slot for a new channel
+        TOO_LARGE,    //!< Value larger than the slot value capacity
+    };
+
+    TlmShmWriter();
+    ~TlmShmWriter();
+
+    //! Create (or replace) the named segment and initialize an empty table
+    //!
+    //! \return OK or OPEN_FAILED, errno is available from getErrno()
+    Status open(const char* name,       //!< Segment name, e.g. "/AlarmedTelem.tlm"
+                uint32_t maxChannels,   //!< Channels the table must hold, rounded up to keep it at most half full
+                uint32_t valueCapacity  //!< Largest serialized value that will be published
+    );
+
+    //! Unmap the segment, removing its name when requested
+    void close(bool unlinkName);
+
+    //! Publish the latest value of a channel
+    Status publish(uint32_t chanId,
+                   uint32_t seconds,
+                   uint32_t useconds,
+                   uint16_t timeBase,
+                   uint8_t timeContext,
+                   const uint8_t* value,
+                   uint32_t length);
+
+    //! errno of the last OPEN_FAILED
+    int getErrno() const { return m_errno; }
+
+  private:
+    //! Find the slot of a channel, claiming an empty one if needed. nullptr when the table is full.
+    TlmShm::Slot* lookup(uint32_t chanId);
+
+    void* m_base;          //!< Mapped segment, nullptr when closed
+    size_t m_size;         //!< Mapped size in bytes
+    uint32_t m_maxClaims;  //!< Slots that may be claimed before the table is considered full
+    char m_name[64];       //!< Segment name for unlinking
+    int m_errno;           //!< errno of the last failed open
+};
+
+}  // namespace FprimeTlmAlarm
+
+#endif
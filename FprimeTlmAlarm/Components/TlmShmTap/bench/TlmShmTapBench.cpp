@@ -0,0 +1,149 @@
+// ======================================================================
+// \title  TlmShmTapBench.cpp
+// \author wmac
+// \brief  Latency and throughput benchmark for the shared-memory telemetry tap
+//
+// A writer thread publishes updates through TlmShmWriter while a reader
+// thread polls them through its own TlmShmReader mapping, as a separate
+// diagnostic process would. Each value carries the publish timestamp so the
+// reader can measure publish-to-observe latency.
+// ======================================================================
+
+#include "FprimeTlmAlarm/Components/TlmShmTap/TlmShmReader.hpp"
+#include "FprimeTlmAlarm/Components/TlmShmTap/TlmShmWriter.hpp"
+
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+void putU64(uint8_t* buf, uint64_t value) {
+    for (uint32_t i = 0; i < 8; i++) {
+        buf[i] = static_cast<uint8_t>(value >> (56 - 8 * i));
+    }
+}
+
+uint64_t getU64(const uint8_t* buf) {
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < 8; i++) {
+        value = (value << 8) | buf[i];
+    }
+    return value;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    uint32_t channels = (argc > 1) ? static_cast<uint32_t>(std::atoi(argv[1])) : 1000;
+    uint32_t updates = (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : 5000000;
+    if (channels == 0 || updates == 0) {
+        (void)std::printf("Usage: %s [channels] [updates]\n", argv[0]);
+        return 1;
+    }
+
+    char name[64];
+    (void)std::snprintf(name, sizeof(name), "/TlmShmTapBench.%d", static_cast<int>(getpid()));
+
+    FprimeTlmAlarm::TlmShmWriter writer;
+    if (writer.open(name, channels, 64) != FprimeTlmAlarm::TlmShmWriter::OK) {
+        (void)std::printf("Could not create %s: %s\n", name, std::strerror(writer.getErrno()));
+        return 1;
+    }
+    // Claim every slot up front so the timed loops measure steady-state updates
+    uint8_t value[64] = {};
+    for (uint32_t chan = 0; chan < channels; chan++) {
+        (void)writer.publish(chan, 0, 0, 0, 0, value, 8);
+    }
+
+    FprimeTlmAlarm::TlmShmReader reader;
+    if (reader.open(name) != FprimeTlmAlarm::TlmShmReader::OK) {
+        (void)std::printf("Could not map %s for reading\n", name);
+        writer.close(true);
+        return 1;
+    }
+    std::vector<FprimeTlmAlarm::TlmShmReader::Handle> handles(channels);
+    for (uint32_t chan = 0; chan < channels; chan++) {
+        handles[chan] = reader.find(chan);
+    }
+
+    std::atomic<bool> done(false);
+    uint64_t reads = 0;
+    uint64_t busy = 0;
+    std::vector<uint64_t> latencyNs;
+    latencyNs.reserve(updates);
+
+    // Start from the prefill so only updates published by the timed loop are measured
+    std::vector<uint32_t> seen(channels);
+    for (uint32_t chan = 0; chan < channels; chan++) {
+        seen[chan] = reader.updates(handles[chan]);
+    }
+
+    std::thread readerThread([&]() {
+        FprimeTlmAlarm::TlmShmReader::Sample sample;
+        uint8_t copy[64];
+        while (!done.load(std::memory_order_acquire)) {
+            for (uint32_t chan = 0; chan < channels; chan++) {
+                // Change detection only touches the sequence, the value is copied when it moved
+                if (reader.updates(handles[chan]) == seen[chan]) {
+                    continue;
+                }
+                const FprimeTlmAlarm::TlmShmReader::Status status =
+                    reader.read(handles[chan], sample, copy, sizeof(copy));
+                reads++;
+                if (status != FprimeTlmAlarm::TlmShmReader::OK) {
+                    busy++;
+                    continue;
+                }
+                seen[chan] = sample.updates;
+                const uint64_t publishedNs = getU64(copy);
+                if (publishedNs != 0) {
+                    latencyNs.push_back(nowNs() - publishedNs);
+                }
+            }
+        }
+    });
+
+    const uint64_t writeStart = nowNs();
+    for (uint32_t update = 0; update < updates; update++) {
+        putU64(value, nowNs());
+        (void)writer.publish(update % channels, update, 0, 0, 0, value, 8);
+    }
+    const uint64_t writeNs = nowNs() - writeStart;
+
+    done.store(true, std::memory_order_release);
+    readerThread.join();
+    reader.close();
+    writer.close(true);
+
+    std::sort(latencyNs.begin(), latencyNs.end());
+    const size_t observed = latencyNs.size();
+    (void)std::printf("channels              %u\n", channels);
+    (void)std::printf("updates published     %u\n", updates);
+    (void)std::printf("publish throughput    %.0f updates/s\n", updates * 1e9 / static_cast<double>(writeNs));
+    (void)std::printf("publish cost          %.1f ns/update\n", static_cast<double>(writeNs) / updates);
+    (void)std::printf("reads (retried/busy)  %llu (%llu)\n", static_cast<unsigned long long>(reads),
+                      static_cast<unsigned long long>(busy));
+    (void)std::printf("updates observed      %zu (%.1f%%, the rest were overwritten before a poll)\n", observed,
+                      100.0 * static_cast<double>(observed) / updates);
+    if (observed > 0) {
+        (void)std::printf("latency p50/p99/max   %llu / %llu / %llu ns\n",
+                          static_cast<unsigned long long>(latencyNs[observed / 2]),
+                          static_cast<unsigned long long>(latencyNs[observed * 99 / 100]),
+                          static_cast<unsigned long long>(latencyNs[observed - 1]));
+    }
+    return 0;
+}
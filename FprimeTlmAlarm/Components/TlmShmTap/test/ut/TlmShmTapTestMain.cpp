@@ -0,0 +1,22 @@
+// ======================================================================
+// \title  TlmShmTapTestMain.cpp
+// \author wmac
+// \brief  cpp file for TlmShmTap component test main function
+// ======================================================================
+
+#include "TlmShmTapTester.hpp"
+
+TEST(Nominal, publishes) {
+    FprimeTlmAlarm::TlmShmTapTester tester;
+    tester.publishes();
+}
+
+TEST(OffNominal, tableFull) {
+    FprimeTlmAlarm::TlmShmTapTester tester;
+    tester.tableFull();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
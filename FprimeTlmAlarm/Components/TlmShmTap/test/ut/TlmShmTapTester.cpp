@@ -0,0 +1,96 @@
+// ======================================================================
+// \title  TlmShmTapTester.cpp
+// \author wmac
+// \brief  cpp file for TlmShmTap component test harness implementation class
+// ======================================================================
+
+#include "TlmShmTapTester.hpp"
+
+#include <unistd.h>
+#include <cstdio>
+
+namespace FprimeTlmAlarm {
+
+// ----------------------------------------------------------------------
+// Construction and destruction
+// ----------------------------------------------------------------------
+
+TlmShmTapTester ::TlmShmTapTester()
+    : TlmShmTapGTestBase("TlmShmTapTester", TlmShmTapTester::MAX_HISTORY_SIZE), component("TlmShmTap") {
+    this->initComponents();
+    this->connectPorts();
+    (void)snprintf(m_name, sizeof(m_name), "/TlmShmTapTester.%d", static_cast<int>(getpid()));
+}
+
+TlmShmTapTester ::~TlmShmTapTester() {
+    this->component.cleanup();
+}
+
+// ----------------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------------
+
+void TlmShmTapTester ::publishes() {
+    const FwChanIdType ID = 0x1700;
+    const U32 ITERS = 3;
+
+    ASSERT_TRUE(this->component.configure(m_name, 16));
+    ASSERT_EVENTS_ShmOpened_SIZE(1);
+
+    TlmShmReader reader;
+    ASSERT_EQ(TlmShmReader::OK, reader.open(m_name));
+    ASSERT_EQ(nullptr, reader.find(ID));
+
+    U8 buf[4] = {0xDE, 0xAD, 0xC0, 0xDE};
+    for (U32 ind = 0; ind < ITERS; ind++) {
+        buf[0] = static_cast<U8>(ind);
+        Fw::TlmBuffer tlm(buf, sizeof(buf));
+        Fw::Time time(1717 + ind, 7171);
+        invoke_to_TlmRecv(0, ID + ind, time, tlm);
+    }
+    // Last value wins
+    buf[0] = 0x17;
+    Fw::TlmBuffer tlm(buf, sizeof(buf));
+    Fw::Time time(1800, 0);
+    invoke_to_TlmRecv(0, ID, time, tlm);
+
+    TlmShmReader::Sample sample;
+    U8 value[FW_TLM_BUFFER_MAX_SIZE];
+    for (U32 ind = 0; ind < ITERS; ind++) {
+        TlmShmReader::Handle handle = reader.find(ID + ind);
+        ASSERT_NE(nullptr, handle);
+        ASSERT_EQ(TlmShmReader::OK, reader.read(handle, sample, value, sizeof(value)));
+        ASSERT_EQ(ID + ind, sample.chanId);
+        ASSERT_EQ(sizeof(buf), sample.length);
+        ASSERT_EQ(0xAD, value[1]);
+        ASSERT_EQ((ind == 0) ? 0x17 : ind, value[0]);
+        ASSERT_EQ((ind == 0) ? 1800U : 1717U + ind, sample.seconds);
+        ASSERT_EQ((ind == 0) ? 2U : 1U, sample.updates);
+    }
+
+    // Values larger than the caller's buffer are flagged, not overrun
+    ASSERT_EQ(TlmShmReader::TOO_SMALL, reader.read(reader.find(ID), sample, value, 2));
+    ASSERT_EVENTS_TableFull_SIZE(0);
+}
+
+void TlmShmTapTester ::tableFull() {
+    const FwChanIdType ID = 0x1700;
+    const U32 CHANNELS = 2;
+
+    ASSERT_TRUE(this->component.configure(m_name, CHANNELS));
+
+    U8 buf[1] = {0};
+    Fw::TlmBuffer tlm(buf, sizeof(buf));
+    Fw::Time time(1717, 7171);
+    for (U32 ind = 0; ind <= CHANNELS; ind++) {
+        invoke_to_TlmRecv(0, ID + ind, time, tlm);
+    }
+    ASSERT_EVENTS_TableFull_SIZE(1);
+    ASSERT_EVENTS_TableFull(0, ID + CHANNELS);
+
+    // Channels already in the table keep updating
+    invoke_to_TlmRecv(0, ID, time, tlm);
+    ASSERT_EVENTS_TableFull_SIZE(1);
+}
+
+}  // namespace FprimeTlmAlarm
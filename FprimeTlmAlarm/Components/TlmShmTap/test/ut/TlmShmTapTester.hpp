@@ -0,0 +1,75 @@
+// ======================================================================
+// \title  TlmShmTapTester.hpp
+// \author wmac
+// \brief  hpp file for TlmShmTap component test harness implementation class
+// ======================================================================
+
+#ifndef FprimeTlmAlarm_TlmShmTapTester_HPP
+#define FprimeTlmAlarm_TlmShmTapTester_HPP
+
+#include "FprimeTlmAlarm/Components/TlmShmTap/TlmShmReader.hpp"
+#include "FprimeTlmAlarm/Components/TlmShmTap/TlmShmTap.hpp"
+#include "FprimeTlmAlarm/Components/TlmShmTap/TlmShmTapGTestBase.hpp"
+
+namespace FprimeTlmAlarm {
+
+class TlmShmTapTester final : public TlmShmTapGTestBase {
+  public:
+    // ----------------------------------------------------------------------
+    // Constants
+    // ----------------------------------------------------------------------
+
+    // Maximum size of histories storing events, telemetry, and port outputs
+    static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+    // Instance ID supplied to the component instance under test
+    static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+  public:
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct object TlmShmTapTester
+    TlmShmTapTester();
+
+    //! Destroy object TlmShmTapTester
+    ~TlmShmTapTester();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    //! Updates are readable from a separate mapping of the segment
+    void publishes();
+
+    //! Channels past the table size are reported and dropped
+    void tableFull();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper functions
+    // ----------------------------------------------------------------------
+
+    //! Connect ports
+    void connectPorts();
+
+    //! Initialize components
+    void initComponents();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Member variables
+    // ----------------------------------------------------------------------
+
+    //! The component under test
+    TlmShmTap component;
+
+    //! Segment name unique to this test process
+    char m_name[64];
+};
+
+}  // namespace FprimeTlmAlarm
+
+#endif
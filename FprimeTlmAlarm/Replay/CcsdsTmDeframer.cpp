@@ -0,0 +1,176 @@
+// ======================================================================
+// \title  CcsdsTmDeframer.cpp
+// \brief  Recovers F´ packets from a recording of CCSDS TM transfer frames
+// ======================================================================
+
+#include "CcsdsTmDeframer.hpp"
+
+#include <Fw/Types/Assert.hpp>
+
+namespace FprimeTlmAlarm {
+
+namespace {
+
+U16 readBe16(const U8* bytes) {
+    return static_cast<U16>((bytes[0] << 8) | bytes[1]);
+}
+
+U32 readBe32(const U8* bytes) {
+    return (static_cast<U32>(bytes[0]) << 24) | (static_cast<U32>(bytes[1]) << 16) |
+           (static_cast<U32>(bytes[2]) << 8) | bytes[3];
+}
+
+//! Byte-at-a-time table for crc16, built on first use
+struct Crc16Table {
+    U16 entries[256];
+
+    Crc16Table() : entries() {
+        for (U32 byte = 0; byte < 256; byte++) {
+            U16 crc = static_cast<U16>(byte << 8);
+            for (U32 bit = 0; bit < 8; bit++) {
+                crc = static_cast<U16>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+            }
+            entries[byte] = crc;
+        }
+    }
+};
+
+}  // namespace
+
+CcsdsTmDeframer ::CcsdsTmDeframer(FwSizeType frameSize)
+    : m_frameSize(frameSize), m_frames(0), m_lostFrames(0), m_skippedBytes(0) {
+    FW_ASSERT(frameSize > MIN_FRAME_SIZE, static_cast<FwAssertArgType>(frameSize));
+}
+
+U16 CcsdsTmDeframer ::crc16(const U8* data, FwSizeType size) {
+    static const Crc16Table table;
+    U16 crc = 0xFFFF;
+    for (FwSizeType i = 0; i < size; i++) {
+        crc = static_cast<U16>((crc << 8) ^ table.entries[((crc >> 8) ^ data[i]) & 0xFF]);
+    }
+    return crc;
+}
+
+bool CcsdsTmDeframer ::deframe(const U8* data, FwSizeType size, TlmPacketSplitter& splitter) {
+    FwSizeType offset = 0;
+    while (offset < size) {
+        const FwSizeType left = size - offset;
+        if (left >= sizeof(U32) && readBe32(data + offset) == ATTACHED_SYNC_MARKER) {
+            offset += sizeof(U32);
+            continue;
+        }
+        if (left < m_frameSize) {
+            m_skippedBytes += left;
+            break;
+        }
+        // After corruption or a partial frame, slide a byte at a time until a frame checks out again
+        if (!frameValid(data + offset)) {
+            offset++;
+            m_skippedBytes++;
+            continue;
+        }
+        m_frames++;
+        if (!takeFrame(data + offset, splitter)) {
+            return false;
+        }
+        offset += m_frameSize;
+    }
+    return true;
+}
+
+bool CcsdsTmDeframer ::frameValid(const U8* frame) const {
+    // Transfer frame version 1 is encoded as 00
+    return (frame[0] >> 6) == 0 &&
+           crc16(frame, m_frameSize - FECF_SIZE) == readBe16(frame + m_frameSize - FECF_SIZE);
+}
+
+bool CcsdsTmDeframer ::takeFrame(const U8* frame, TlmPacketSplitter& splitter) {
+    const U8 vcid = static_cast<U8>((frame[1] >> 1) & 0x7);
+    const bool hasOcf = (frame[1] & 0x1) != 0;
+    const U8 vcCount = frame[3];
+    const U16 status = readBe16(frame + 4);
+    const U16 firstHeader = static_cast<U16>(status & 0x7FF);
+
+    const U8* dataStart = frame + PRIMARY_HEADER_SIZE;
+    const U8* const dataEnd = frame + m_frameSize - FECF_SIZE - (hasOcf ? OCF_SIZE : 0);
+    if ((status & 0x8000) != 0) {
+        // Secondary header: the low 6 bits of its first byte are its length - 1
+        dataStart += (dataStart[0] & 0x3F) + 1;
+    }
+    if (dataStart >= dataEnd) {
+        return true;
+    }
+    const FwSizeType dataSize = static_cast<FwSizeType>(dataEnd - dataStart);
+
+    VirtualChannel& channel = m_channels[vcid];
+    if (channel.synced && vcCount != channel.nextCount) {
+        // A packet continued from before the gap is incomplete
+        m_lostFrames += static_cast<U8>(vcCount - channel.nextCount);
+        channel.synced = false;
+        channel.pending.clear();
+    }
+    channel.nextCount = static_cast<U8>(vcCount + 1);
+    if (firstHeader == FHP_IDLE_DATA) {
+        channel.synced = true;
+        channel.pending.clear();
+        return true;
+    }
+
+    if (channel.synced && !channel.pending.empty()) {
+        channel.pending.insert(channel.pending.end(), dataStart, dataEnd);
+        FwSizeType used = 0;
+        if (!takePackets(channel.pending.data(), channel.pending.size(), channel, used, splitter)) {
+            return false;
+        }
+        if (channel.synced) {
+            channel.pending.erase(channel.pending.begin(), channel.pending.begin() + static_cast<std::ptrdiff_t>(used));
+            return true;
+        }
+        // The continuation did not line up, pick up again at this frame's first packet
+        channel.pending.clear();
+    }
+
+    if (firstHeader == FHP_NO_PACKET_START || firstHeader >= dataSize) {
+        channel.synced = false;
+        return true;
+    }
+    channel.synced = true;
+    FwSizeType used = 0;
+    if (!takePackets(dataStart + firstHeader, dataSize - firstHeader, channel, used, splitter)) {
+        return false;
+    }
+    if (channel.synced) {
+        channel.pending.assign(dataStart + firstHeader + used, dataEnd);
+    } else {
+        channel.pending.clear();
+    }
+    return true;
+}
+
+bool CcsdsTmDeframer ::takePackets(const U8* data,
+                                   FwSizeType size,
+                                   VirtualChannel& channel,
+                                   FwSizeType& used,
+                                   TlmPacketSplitter& splitter) {
+    used = 0;
+    while (size - used >= SPACE_PACKET_HEADER_SIZE) {
+        const U8* const header = data + used;
+        // Packet version number 1 is encoded as 000
+        if ((header[0] >> 5) != 0) {
+            channel.synced = false;
+            return true;
+        }
+        const FwSizeType total = SPACE_PACKET_HEADER_SIZE + readBe16(header + 4) + 1U;
+        if (size - used < total) {
+            break;
+        }
+        if ((readBe16(header) & 0x7FF) != IDLE_APID &&
+            !splitter.split(header + SPACE_PACKET_HEADER_SIZE, total - SPACE_PACKET_HEADER_SIZE)) {
+            return false;
+        }
+        used += total;
+    }
+    return true;
+}
+
+}  // namespace FprimeTlmAlarm
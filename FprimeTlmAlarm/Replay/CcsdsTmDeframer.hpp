@@ -0,0 +1,81 @@
+// ======================================================================
+// \title  CcsdsTmDeframer.hpp
+// \brief  Recovers F´ packets from a recording of CCSDS TM transfer frames
+//
+// ComCcsds downlinks F´ packets as CCSDS space packets carried in fixed
+// size TM transfer frames, which is what the GDS records. Frames are
+// checked with their frame error control field, space packets are
+// reassembled across frames of each virtual channel, and the payload of
+// every non-idle space packet (the F´ packet, descriptor first) is passed
+// to a TlmPacketSplitter.
+// ======================================================================
+
+#ifndef FprimeTlmAlarm_CcsdsTmDeframer_HPP
+#define FprimeTlmAlarm_CcsdsTmDeframer_HPP
+
+#include "TlmPacketSplitter.hpp"
+
+#include <vector>
+
+namespace FprimeTlmAlarm {
+
+class CcsdsTmDeframer {
+  public:
+    static constexpr FwSizeType PRIMARY_HEADER_SIZE = 6;       //!< TM transfer frame primary header
+    static constexpr FwSizeType FECF_SIZE = 2;                 //!< CRC-16 frame error control field
+    static constexpr FwSizeType OCF_SIZE = 4;                  //!< Operational control field, when flagged
+    static constexpr FwSizeType SPACE_PACKET_HEADER_SIZE = 6;  //!< Space packet primary header
+    static constexpr U16 IDLE_APID = 0x7FF;                    //!< APID of idle space packets
+    static constexpr U16 FHP_NO_PACKET_START = 0x7FF;          //!< First header pointer: no packet starts here
+    static constexpr U16 FHP_IDLE_DATA = 0x7FE;                //!< First header pointer: only idle data
+    static constexpr U32 ATTACHED_SYNC_MARKER = 0x1ACFFC1D;    //!< Skipped when a link layer kept it
+    static constexpr U8 NUM_VIRTUAL_CHANNELS = 8;              //!< Virtual channel IDs are 3 bits
+
+    //! Frames must be longer than their headers and trailers
+    static constexpr FwSizeType MIN_FRAME_SIZE = PRIMARY_HEADER_SIZE + OCF_SIZE + FECF_SIZE;
+
+    //! Frames of frameSize bytes, the size the flight software frames with (ComCfg.TmFrameFixedSize)
+    explicit CcsdsTmDeframer(FwSizeType frameSize);
+
+    //! Deframe a whole recording into splitter, false if the splitter's sink asked to stop
+    bool deframe(const U8* data, FwSizeType size, TlmPacketSplitter& splitter);
+
+    //! CRC-16-CCITT (polynomial 0x1021, initial value 0xFFFF) as used by the frame error control field
+    static U16 crc16(const U8* data, FwSizeType size);
+
+    U64 frames() const { return m_frames; }              //!< Frames that passed their check
+    U64 lostFrames() const { return m_lostFrames; }      //!< Frames missing from a virtual channel's count
+    U64 skippedBytes() const { return m_skippedBytes; }  //!< Bytes dropped while looking for a valid frame
+
+  private:
+    //! Reassembly state of one virtual channel
+    struct VirtualChannel {
+        bool synced = false;      //!< A packet boundary is known
+        U8 nextCount = 0;         //!< Expected virtual channel frame count
+        std::vector<U8> pending;  //!< Start of a packet continued in the next frame
+    };
+
+    //! Whether a valid frame starts at frame
+    bool frameValid(const U8* frame) const;
+
+    //! Take one valid frame's data field into its virtual channel
+    bool takeFrame(const U8* frame, TlmPacketSplitter& splitter);
+
+    //! Pass the complete packets at the start of data to the splitter, returning the bytes used. Sets synced to
+    //! false when the bytes cannot be a space packet.
+    bool takePackets(const U8* data,
+                     FwSizeType size,
+                     VirtualChannel& channel,
+                     FwSizeType& used,
+                     TlmPacketSplitter& splitter);
+
+    FwSizeType m_frameSize;                           //!< Bytes per frame, FECF included
+    VirtualChannel m_channels[NUM_VIRTUAL_CHANNELS];  //!< Reassembly state by virtual channel ID
+    U64 m_frames;                                     //!< Frames that passed their check
+    U64 m_lostFrames;                                 //!< Frames missing from the counts
+    U64 m_skippedBytes;                               //!< Bytes skipped while resynchronizing
+};
+
+}  // namespace FprimeTlmAlarm
+
+#endif
@@ -0,0 +1,491 @@
+// ======================================================================
+// \title  TlmDictionary.cpp
+// \brief  Telemetry layouts from an F´ JSON topology dictionary
+// ======================================================================
+
+#include "TlmDictionary.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace FprimeTlmAlarm {
+
+namespace {
+
+//! Nesting deeper than any dictionary produces is treated as malformed rather than recursed into
+constexpr U32 MAX_DEPTH = 64;
+
+//! Parsed JSON value, object members are kept in document order
+struct JsonValue {
+    enum Kind { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+    Kind kind = NUL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    //! Member named key of an object, nullptr if absent or not an object
+    const JsonValue* get(const char* key) const {
+        for (const std::pair<std::string, JsonValue>& member : members) {
+            if (member.first == key) {
+                return &member.second;
+            }
+        }
+        return nullptr;
+    }
+
+    //! String member named key, nullptr if absent or not a string
+    const char* getString(const char* key) const {
+        const JsonValue* value = get(key);
+        return (value != nullptr && value->kind == STRING) ? value->text.c_str() : nullptr;
+    }
+
+    //! Non-negative integer member named key, false if absent or not one
+    bool getUnsigned(const char* key, U64& out) const {
+        const JsonValue* value = get(key);
+        if (value == nullptr || value->kind != NUMBER || value->number < 0.0 ||
+            value->number != static_cast<double>(static_cast<U64>(value->number))) {
+            return false;
+        }
+        out = static_cast<U64>(value->number);
+        return true;
+    }
+};
+
+//! Recursive descent parser over a NUL-terminated document
+class JsonParser {
+  public:
+    explicit JsonParser(const char* text) : m_start(text), m_cursor(text) {}
+
+    bool parse(JsonValue& value) {
+        if (!parseValue(value, 0)) {
+            return false;
+        }
+        skipSpace();
+        return *m_cursor == '\0';
+    }
+
+    size_t offset() const { return static_cast<size_t>(m_cursor - m_start); }
+
+  private:
+    void skipSpace() {
+        while (*m_cursor == ' ' || *m_cursor == '\t' || *m_cursor == '\n' || *m_cursor == '\r') {
+            m_cursor++;
+        }
+    }
+
+    bool literal(const char* word) {
+        const size_t length = std::strlen(word);
+        if (std::strncmp(m_cursor, word, length) != 0) {
+            return false;
+        }
+        m_cursor += length;
+        return true;
+    }
+
+    bool parseValue(JsonValue& value, U32 depth) {
+        skipSpace();
+        if (depth > MAX_DEPTH) {
+            return false;
+        }
+        switch (*m_cursor) {
+            case '{':
+                value.kind = JsonValue::OBJECT;
+                return parseObject(value, depth);
+            case '[':
+                value.kind = JsonValue::ARRAY;
+                return parseArray(value, depth);
+            case '"':
+                value.kind = JsonValue::STRING;
+                return parseString(value.text);
+            case 't':
+                value.kind = JsonValue::BOOLEAN;
+                value.boolean = true;
+                return literal("true");
+            case 'f':
+                value.kind = JsonValue::BOOLEAN;
+                return literal("false");
+            case 'n':
+                return literal("null");
+            default:
+                value.kind = JsonValue::NUMBER;
+                return parseNumber(value.number);
+        }
+    }
+
+    bool parseObject(JsonValue& value, U32 depth) {
+        m_cursor++;
+        skipSpace();
+        if (*m_cursor == '}') {
+            m_cursor++;
+            return true;
+        }
+        while (true) {
+            skipSpace();
+            value.members.emplace_back();
+            std::pair<std::string, JsonValue>& member = value.members.back();
+            if (*m_cursor != '"' || !parseString(member.first)) {
+                return false;
+            }
+            skipSpace();
+            if (*m_cursor++ != ':' || !parseValue(member.second, depth + 1)) {
+                return false;
+            }
+            skipSpace();
+            if (*m_cursor == '}') {
+                m_cursor++;
+                return true;
+            }
+            if (*m_cursor++ != ',') {
+                return false;
+            }
+        }
+    }
+
+    bool parseArray(JsonValue& value, U32 depth) {
+        m_cursor++;
+        skipSpace();
+        if (*m_cursor == ']') {
+            m_cursor++;
+            return true;
+        }
+        while (true) {
+            value.items.emplace_back();
+            if (!parseValue(value.items.back(), depth + 1)) {
+                return false;
+            }
+            skipSpace();
+            if (*m_cursor == ']') {
+                m_cursor++;
+                return true;
+            }
+            if (*m_cursor++ != ',') {
+                return false;
+            }
+        }
+    }
+
+    bool parseHex4(U32& code) {
+        code = 0;
+        for (U32 i = 0; i < 4; i++) {
+            const char c = *m_cursor++;
+            code <<= 4;
+            if (c >= '0' && c <= '9') {
+                code |= static_cast<U32>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                code |= static_cast<U32>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                code |= static_cast<U32>(c - 'A' + 10);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool parseString(std::string& text) {
+        m_cursor++;
+        while (*m_cursor != '"') {
+            const char c = *m_cursor++;
+            if (c == '\0') {
+                return false;
+            }
+            if (c != '\\') {
+                text.push_back(c);
+                continue;
+            }
+            const char escape = *m_cursor++;
+            switch (escape) {
+                case '"':
+                case '\\':
+                case '/':
+                    text.push_back(escape);
+                    break;
+                case 'b':
+                    text.push_back('\b');
+                    break;
+                case 'f':
+                    text.push_back('\f');
+                    break;
+                case 'n':
+                    text.push_back('\n');
+                    break;
+                case 'r':
+                    text.push_back('\r');
+                    break;
+                case 't':
+                    text.push_back('\t');
+                    break;
+                case 'u': {
+                    U32 code = 0;
+                    if (!parseHex4(code)) {
+                        return false;
+                    }
+                    // Names are ASCII, anything else only appears in annotations and just has to be skipped cleanly
+                    text.push_back((code < 0x80) ? static_cast<char>(code) : '?');
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        m_cursor++;
+        return true;
+    }
+
+    bool parseNumber(double& number) {
+        char* end = nullptr;
+        number = std::strtod(m_cursor, &end);
+        if (end == m_cursor) {
+            return false;
+        }
+        m_cursor = end;
+        return true;
+    }
+
+    const char* m_start;
+    const char* m_cursor;
+};
+
+//! Type definitions of the dictionary by qualified name
+using TypeDefinitions = std::unordered_map<std::string, const JsonValue*>;
+
+//! Append a fixed run, merged into the previous one when that is fixed too
+void appendFixed(TlmDictionary::Layout& layout, FwSizeType size) {
+    if (!layout.segments.empty() && !layout.segments.back().string) {
+        layout.segments.back().size += size;
+    } else {
+        layout.segments.push_back({false, size});
+    }
+    layout.slotSize += size;
+}
+
+//! Append the serialized layout of a dictionary type descriptor
+bool appendType(const JsonValue& type, const TypeDefinitions& definitions, U32 depth, TlmDictionary::Layout& layout) {
+    const char* kind = type.getString("kind");
+    if (kind == nullptr || depth > MAX_DEPTH) {
+        return false;
+    }
+    U64 size = 0;
+    if (std::strcmp(kind, "integer") == 0 || std::strcmp(kind, "float") == 0 || std::strcmp(kind, "bool") == 0) {
+        if (!type.getUnsigned("size", size) || size == 0 || size % 8 != 0) {
+            return false;
+        }
+        appendFixed(layout, static_cast<FwSizeType>(size / 8));
+        return true;
+    }
+    if (std::strcmp(kind, "string") == 0) {
+        if (!type.getUnsigned("size", size)) {
+            return false;
+        }
+        layout.segments.push_back({true, static_cast<FwSizeType>(size)});
+        layout.slotSize += sizeof(FwSizeStoreType) + static_cast<FwSizeType>(size);
+        return true;
+    }
+    if (std::strcmp(kind, "qualifiedIdentifier") != 0) {
+        return false;
+    }
+
+    const char* name = type.getString("name");
+    const TypeDefinitions::const_iterator found = (name != nullptr) ? definitions.find(name) : definitions.end();
+    if (found == definitions.end()) {
+        return false;
+    }
+    const JsonValue& definition = *found->second;
+    const char* definitionKind = definition.getString("kind");
+    if (definitionKind == nullptr) {
+        return false;
+    }
+    if (std::strcmp(definitionKind, "enum") == 0) {
+        const JsonValue* representation = definition.get("representationType");
+        return representation != nullptr && appendType(*representation, definitions, depth + 1, layout);
+    }
+    if (std::strcmp(definitionKind, "alias") == 0) {
+        const JsonValue* underlying = definition.get("underlyingType");
+        return underlying != nullptr && appendType(*underlying, definitions, depth + 1, layout);
+    }
+    if (std::strcmp(definitionKind, "array") == 0) {
+        const JsonValue* element = definition.get("elementType");
+        if (element == nullptr || !definition.getUnsigned("size", size)) {
+            return false;
+        }
+        for (U64 i = 0; i < size; i++) {
+            if (!appendType(*element, definitions, depth + 1, layout)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (std::strcmp(definitionKind, "struct") == 0) {
+        // Members are serialized in declaration order, which the dictionary gives as an index
+        const JsonValue* members = definition.get("members");
+        if (members == nullptr || members->kind != JsonValue::OBJECT) {
+            return false;
+        }
+        std::vector<const JsonValue*> ordered(members->members.size(), nullptr);
+        for (const std::pair<std::string, JsonValue>& member : members->members) {
+            U64 index = 0;
+            if (!member.second.getUnsigned("index", index) || index >= ordered.size() || ordered[index] != nullptr) {
+                return false;
+            }
+            ordered[index] = &member.second;
+        }
+        for (const JsonValue* member : ordered) {
+            const JsonValue* memberType = member->get("type");
+            // A member declared as an array carries its element count as size
+            U64 count = 1;
+            if (member->get("size") != nullptr && !member->getUnsigned("size", count)) {
+                return false;
+            }
+            for (U64 i = 0; i < count; i++) {
+                if (memberType == nullptr || !appendType(*memberType, definitions, depth + 1, layout)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+bool TlmDictionary ::load(const char* path) {
+    FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) {
+        (void)std::fprintf(stderr, "Could not open dictionary %s\n", path);
+        return false;
+    }
+    std::string text;
+    char chunk[65536];
+    size_t read = 0;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        text.append(chunk, read);
+    }
+    (void)std::fclose(file);
+    return parse(text.c_str(), path);
+}
+
+bool TlmDictionary ::parse(const char* text, const char* source) {
+    m_channels.clear();
+    m_packets.clear();
+
+    JsonValue root;
+    JsonParser parser(text);
+    if (!parser.parse(root) || root.kind != JsonValue::OBJECT) {
+        (void)std::fprintf(stderr, "%s: malformed JSON near offset %zu\n", source, parser.offset());
+        return false;
+    }
+
+    TypeDefinitions definitions;
+    const JsonValue* types = root.get("typeDefinitions");
+    if (types != nullptr) {
+        for (const JsonValue& type : types->items) {
+            const char* name = type.getString("qualifiedName");
+            if (name != nullptr) {
+                definitions[name] = &type;
+            }
+        }
+    }
+
+    const JsonValue* channels = root.get("telemetryChannels");
+    if (channels == nullptr || channels->kind != JsonValue::ARRAY) {
+        (void)std::fprintf(stderr, "%s: no telemetryChannels, not a topology dictionary\n", source);
+        return false;
+    }
+    std::unordered_map<std::string, FwChanIdType> ids;
+    for (const JsonValue& channel : channels->items) {
+        const char* name = channel.getString("name");
+        const JsonValue* type = channel.get("type");
+        U64 id = 0;
+        Layout layout;
+        if (name == nullptr || type == nullptr || !channel.getUnsigned("id", id) ||
+            !appendType(*type, definitions, 0, layout)) {
+            (void)std::fprintf(stderr, "%s: cannot lay out channel %s\n", source, (name != nullptr) ? name : "?");
+            return false;
+        }
+        m_channels[static_cast<FwChanIdType>(id)] = std::move(layout);
+        ids[name] = static_cast<FwChanIdType>(id);
+    }
+
+    // Only the first packet set is used, a deployment packetizes with one
+    const JsonValue* packetSets = root.get("telemetryPacketSets");
+    if (packetSets == nullptr || packetSets->items.empty()) {
+        return true;
+    }
+    const JsonValue* packets = packetSets->items[0].get("members");
+    if (packets == nullptr) {
+        return true;
+    }
+    for (const JsonValue& packet : packets->items) {
+        const JsonValue* members = packet.get("members");
+        U64 id = 0;
+        if (members == nullptr || !packet.getUnsigned("id", id)) {
+            (void)std::fprintf(stderr, "%s: malformed telemetry packet\n", source);
+            return false;
+        }
+        std::vector<FwChanIdType>& layout = m_packets[static_cast<FwTlmPacketizeIdType>(id)];
+        for (const JsonValue& member : members->items) {
+            const std::unordered_map<std::string, FwChanIdType>::const_iterator found = ids.find(member.text);
+            if (member.kind != JsonValue::STRING || found == ids.end()) {
+                (void)std::fprintf(stderr, "%s: packet %llu lists unknown channel %s\n", source,
+                                   static_cast<unsigned long long>(id), member.text.c_str());
+                return false;
+            }
+            layout.push_back(found->second);
+        }
+    }
+    return true;
+}
+
+bool TlmDictionary ::valueSize(FwChanIdType id, const U8* bytes, FwSizeType available, FwSizeType& size) const {
+    const std::unordered_map<FwChanIdType, Layout>::const_iterator found = m_channels.find(id);
+    if (found == m_channels.end()) {
+        return false;
+    }
+    FwSizeType offset = 0;
+    for (const Segment& segment : found->second.segments) {
+        if (!segment.string) {
+            offset += segment.size;
+            continue;
+        }
+        if (available < offset || available - offset < sizeof(FwSizeStoreType)) {
+            return false;
+        }
+        FwSizeType length = 0;
+        for (FwSizeType i = 0; i < sizeof(FwSizeStoreType); i++) {
+            length = (length << 8) | bytes[offset + i];
+        }
+        if (length > segment.size) {
+            return false;
+        }
+        offset += sizeof(FwSizeStoreType) + length;
+    }
+    if (offset > available) {
+        return false;
+    }
+    size = offset;
+    return true;
+}
+
+bool TlmDictionary ::slotSize(FwChanIdType id, FwSizeType& size) const {
+    const std::unordered_map<FwChanIdType, Layout>::const_iterator found = m_channels.find(id);
+    if (found == m_channels.end()) {
+        return false;
+    }
+    size = found->second.slotSize;
+    return true;
+}
+
+const std::vector<FwChanIdType>* TlmDictionary ::packet(FwTlmPacketizeIdType id) const {
+    const std::unordered_map<FwTlmPacketizeIdType, std::vector<FwChanIdType>>::const_iterator found =
+        m_packets.find(id);
+    return (found != m_packets.end()) ? &found->second : nullptr;
+}
+
+}  // namespace FprimeTlmAlarm
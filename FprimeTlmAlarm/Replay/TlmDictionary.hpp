@@ -0,0 +1,64 @@
+// ======================================================================
+// \title  TlmDictionary.hpp
+// \brief  Telemetry layouts from an F´ JSON topology dictionary
+//
+// Channel values carry no length on the wire, so splitting a TlmChan packet
+// or a TlmPacketizer packet back into channel updates needs the type of
+// every channel. This loads just enough of the dictionary to do that.
+// ======================================================================
+
+#ifndef FprimeTlmAlarm_TlmDictionary_HPP
+#define FprimeTlmAlarm_TlmDictionary_HPP
+
+#include <Fw/FPrimeBasicTypes.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace FprimeTlmAlarm {
+
+class TlmDictionary {
+  public:
+    //! Load the channels, type definitions and first telemetry packet set of a dictionary, false on any error
+    bool load(const char* path);
+
+    //! Load from dictionary text already in memory, source names it in error messages
+    bool parse(const char* text, const char* source);
+
+    //! Size of the value of channel id serialized at bytes, as TlmChan sends it. False if the channel is unknown or
+    //! the value does not fit in available bytes.
+    bool valueSize(FwChanIdType id, const U8* bytes, FwSizeType available, FwSizeType& size) const;
+
+    //! Size of the fixed slot channel id takes in a TlmPacketizer packet, false if the channel is unknown
+    bool slotSize(FwChanIdType id, FwSizeType& size) const;
+
+    //! Channels of TlmPacketizer packet id in the order their slots are laid out, nullptr if the packet is unknown
+    const std::vector<FwChanIdType>* packet(FwTlmPacketizeIdType id) const;
+
+    //! Number of channels loaded
+    FwSizeType channelCount() const { return m_channels.size(); }
+
+    //! Number of telemetry packets loaded
+    FwSizeType packetCount() const { return m_packets.size(); }
+
+  public:
+    //! Run of a serialized value: a fixed number of bytes, or a length-prefixed string of at most size bytes
+    struct Segment {
+        bool string;      //!< Length-prefixed string
+        FwSizeType size;  //!< Bytes, or largest string length
+    };
+
+    //! Serialized layout of one channel's type
+    struct Layout {
+        std::vector<Segment> segments;  //!< Runs in serialization order, adjacent fixed runs merged
+        FwSizeType slotSize = 0;        //!< Bytes the value takes with every string at its largest
+    };
+
+  private:
+    std::unordered_map<FwChanIdType, Layout> m_channels;                             //!< Layout of each channel
+    std::unordered_map<FwTlmPacketizeIdType, std::vector<FwChanIdType>> m_packets;  //!< Channels of each packet
+};
+
+}  // namespace FprimeTlmAlarm
+
+#endif
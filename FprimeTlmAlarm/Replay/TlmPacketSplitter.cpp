@@ -0,0 +1,106 @@
+// ======================================================================
+// \title  TlmPacketSplitter.cpp
+// \brief  Splits F´ telemetry packets back into channel updates
+// ======================================================================
+
+#include "TlmPacketSplitter.hpp"
+
+namespace FprimeTlmAlarm {
+
+namespace {
+
+//! Read a big-endian integer of the given size
+U64 readBe(const U8* bytes, FwSizeType size) {
+    U64 value = 0;
+    for (FwSizeType i = 0; i < size; i++) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+//! Read a serialized Fw::Time
+Fw::Time readTime(const U8* bytes) {
+    const U64 timeBase = readBe(bytes, sizeof(FwTimeBaseStoreType));
+    bytes += sizeof(FwTimeBaseStoreType);
+    const U64 timeContext = readBe(bytes, sizeof(FwTimeContextStoreType));
+    bytes += sizeof(FwTimeContextStoreType);
+    return Fw::Time(static_cast<TimeBase::T>(timeBase), static_cast<FwTimeContextStoreType>(timeContext),
+                    static_cast<U32>(readBe(bytes, 4)), static_cast<U32>(readBe(bytes + 4, 4)));
+}
+
+}  // namespace
+
+TlmPacketSplitter ::TlmPacketSplitter(const TlmDictionary* dictionary, UpdateSink& sink)
+    : m_dictionary(dictionary), m_sink(sink), m_packets(0), m_cutShort(0) {}
+
+bool TlmPacketSplitter ::split(const U8* packet, FwSizeType size) {
+    m_packets++;
+    if (size < sizeof(FwPacketDescriptorType)) {
+        return true;
+    }
+    const U64 descriptor = readBe(packet, sizeof(FwPacketDescriptorType));
+    const U8* const field = packet + sizeof(FwPacketDescriptorType);
+    const U8* const end = packet + size;
+    if (descriptor == PACKET_TELEM) {
+        return splitTlmChan(field, end);
+    }
+    if (descriptor == PACKET_PACKETIZED_TLM) {
+        return splitPacketized(field, end);
+    }
+    return true;
+}
+
+bool TlmPacketSplitter ::splitTlmChan(const U8* field, const U8* end) {
+    // Only the dictionary knows where a value ends, without it the value is the rest of the packet
+    while (static_cast<FwSizeType>(end - field) >= sizeof(FwChanIdType) + TIME_SIZE) {
+        const FwChanIdType id = static_cast<FwChanIdType>(readBe(field, sizeof(FwChanIdType)));
+        const Fw::Time timeTag = readTime(field + sizeof(FwChanIdType));
+        field += sizeof(FwChanIdType) + TIME_SIZE;
+        FwSizeType valueSize = static_cast<FwSizeType>(end - field);
+        if ((m_dictionary != nullptr && !m_dictionary->valueSize(id, field, valueSize, valueSize)) ||
+            valueSize > FW_TLM_BUFFER_MAX_SIZE) {
+            m_cutShort++;
+            return true;
+        }
+        if (!m_sink.update(id, timeTag, field, valueSize)) {
+            return false;
+        }
+        field += valueSize;
+    }
+    // Leftover bytes too short for another entry mean the packet was cut
+    if (field != end) {
+        m_cutShort++;
+    }
+    return true;
+}
+
+bool TlmPacketSplitter ::splitPacketized(const U8* field, const U8* end) {
+    if (m_dictionary == nullptr || static_cast<FwSizeType>(end - field) < sizeof(FwTlmPacketizeIdType) + TIME_SIZE) {
+        m_cutShort++;
+        return true;
+    }
+    const std::vector<FwChanIdType>* channels =
+        m_dictionary->packet(static_cast<FwTlmPacketizeIdType>(readBe(field, sizeof(FwTlmPacketizeIdType))));
+    const Fw::Time timeTag = readTime(field + sizeof(FwTlmPacketizeIdType));
+    field += sizeof(FwTlmPacketizeIdType) + TIME_SIZE;
+    if (channels == nullptr) {
+        m_cutShort++;
+        return true;
+    }
+    for (const FwChanIdType id : *channels) {
+        // Every channel of a loaded packet has a layout, load checks the packet members
+        FwSizeType slotSize = 0;
+        (void)m_dictionary->slotSize(id, slotSize);
+        if (static_cast<FwSizeType>(end - field) < slotSize || slotSize > FW_TLM_BUFFER_MAX_SIZE) {
+            m_cutShort++;
+            return true;
+        }
+        if (!m_sink.update(id, timeTag, field, slotSize)) {
+            return false;
+        }
+        field += slotSize;
+    }
+    return true;
+}
+
+}  // namespace FprimeTlmAlarm
@@ -0,0 +1,64 @@
+// ======================================================================
+// \title  TlmPacketSplitter.hpp
+// \brief  Splits F´ telemetry packets back into channel updates
+//
+// TlmChan packets hold (channel ID, time tag, value) entries back to back,
+// TlmPacketizer packets a packet ID, one time tag and a fixed slot per
+// channel. Values carry no length, so both need the dictionary to split;
+// without one a TlmChan packet is taken to hold a single channel.
+// ======================================================================
+
+#ifndef FprimeTlmAlarm_TlmPacketSplitter_HPP
+#define FprimeTlmAlarm_TlmPacketSplitter_HPP
+
+#include "TlmDictionary.hpp"
+
+#include <Fw/Time/Time.hpp>
+
+namespace FprimeTlmAlarm {
+
+class TlmPacketSplitter {
+  public:
+    //! Descriptors of telemetry packets, see Fw::ComPacketType
+    static constexpr U32 PACKET_TELEM = 1;
+    static constexpr U32 PACKET_PACKETIZED_TLM = 4;
+
+    //! Serialized Fw::Time: time base, time context, seconds, microseconds
+    static constexpr FwSizeType TIME_SIZE =
+        sizeof(FwTimeBaseStoreType) + sizeof(FwTimeContextStoreType) + 2 * sizeof(U32);
+
+    //! Receives the channel updates split out of each packet
+    class UpdateSink {
+      public:
+        virtual ~UpdateSink() = default;
+
+        //! Handle one channel update, false to stop splitting
+        virtual bool update(FwChanIdType id, const Fw::Time& timeTag, const U8* value, FwSizeType size) = 0;
+    };
+
+    //! Split with the channel layouts of dictionary, or nullptr to accept single-channel TlmChan packets only
+    TlmPacketSplitter(const TlmDictionary* dictionary, UpdateSink& sink);
+
+    //! Pass every channel update of an F´ packet (descriptor first) to the sink. Packets other than telemetry are
+    //! ignored. False if the sink asked to stop.
+    bool split(const U8* packet, FwSizeType size);
+
+    //! Packets passed to split
+    U64 packets() const { return m_packets; }
+
+    //! Telemetry packets that could not be split to the end: unknown channel or packet, or truncated
+    U64 cutShort() const { return m_cutShort; }
+
+  private:
+    bool splitTlmChan(const U8* field, const U8* end);
+    bool splitPacketized(const U8* field, const U8* end);
+
+    const TlmDictionary* m_dictionary;  //!< Channel layouts, nullptr without a dictionary
+    UpdateSink& m_sink;                 //!< Receiver of the updates
+    U64 m_packets;                      //!< Packets passed to split
+    U64 m_cutShort;                     //!< Telemetry packets not split to the end
+};
+
+}  // namespace FprimeTlmAlarm
+
+#endif
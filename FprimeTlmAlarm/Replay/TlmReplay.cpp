@@ -0,0 +1,528 @@
+// ======================================================================
+// \title  TlmReplay.cpp
+// \brief  Offline max-speed replay of recorded telemetry through TlmSplitter -> TlmAlarm
+//
+// The recording is mmap'd and streamed record by record. Time comes from a
+// virtual clock that follows the recording, and rate group ticks are
+// synthesized whenever the recording crosses a tick boundary, so no
+// LinuxTimer or rate group threads are needed and the replay runs as fast as
+// the CPU allows. Alarm transitions are printed to stdout with their
+// recording time, followed by a throughput and per-tick cost summary.
+// ======================================================================
+
+#include "CcsdsTmDeframer.hpp"
+#include "TlmDictionary.hpp"
+#include "TlmPacketSplitter.hpp"
+
+#include <FprimeTlmAlarm/Components/TlmAlarm/TlmAlarm.hpp>
+#include <FprimeTlmAlarm/Components/TlmSplitter/TlmSplitter.hpp>
+#include <Fw/Log/LogTextPortAc.hpp>
+#include <Fw/Types/MallocAllocator.hpp>
+#include <Fw/Time/TimePortAc.hpp>
+#include <Os/Os.hpp>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+//! Command line configuration of one replay
+struct ReplayConfig {
+    const char* recording = nullptr;   //!< Recording of TM frames as the GDS logs them, or of sized F´ packets
+    FwSizeType frameSize = 1024;       //!< TM frame length (ComCfg.TmFrameFixedSize), 0 for sized F´ packets
+    const char* alarms = nullptr;      //!< Alarm definition file
+    const char* dictionary = nullptr;  //!< JSON topology dictionary used to split packets, optional
+    U64 tickUsec = 1000000;            //!< Virtual time between run ticks
+    U32 context = 0;                   //!< run context, i.e. the scheduling group replayed
+    FwSizeType queueDepth = 65536;     //!< TlmAlarm queue depth, must hold every update between two ticks
+    U16 maxAlarms = 4096;              //!< TlmAlarm alarm table size
+    U16 maxChannels = 4096;            //!< TlmAlarm channel cache size
+    U32 historyDepth = 256;            //!< TlmAlarm history ring size, nothing drains it during a replay
+    U32 threads = 1;                   //!< Threads evaluating alarms, the run thread plus threads - 1 workers
+    bool sweep = false;                //!< Replay once per thread count from 1 to threads
+    bool printTransitions = true;      //!< Print transitions to stdout
+};
+
+//! Measurements of one replay
+struct ReplayResult {
+    U64 frames = 0;                              //!< TM frames that passed their check
+    U64 lostFrames = 0;                          //!< TM frames missing from the frame counts
+    U64 skippedBytes = 0;                        //!< Recording bytes that were not part of a valid frame
+    U64 records = 0;                             //!< F´ packets in the recording
+    U64 updates = 0;                             //!< Telemetry updates replayed
+    U64 cutShort = 0;                            //!< Telemetry packets that could not be split to the end
+    U64 transitions = 0;                         //!< Alarm transitions reported
+    U64 transitionHash = 0xCBF29CE484222325ULL;  //!< FNV-1a digest of the transitions in report order
+    U64 wallNs = 0;                              //!< Wall time of the replay loop
+    std::vector<U32> tickNs;                     //!< Wall time of every run tick
+};
+
+//! Read a big-endian integer of the given size
+U64 readBe(const U8* bytes, FwSizeType size) {
+    U64 value = 0;
+    for (FwSizeType i = 0; i < size; i++) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+//! Read-only mapping of the recording, released on destruction
+class Recording {
+  public:
+    Recording() : m_data(nullptr), m_size(0) {}
+    ~Recording() {
+        if (m_data != nullptr) {
+            (void)munmap(const_cast<U8*>(m_data), m_size);
+        }
+    }
+
+    bool open(const char* path) {
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            (void)::close(fd);
+            return false;
+        }
+        m_size = static_cast<size_t>(info.st_size);
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        (void)::close(fd);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+        // Pages are touched once, front to back
+        (void)madvise(data, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const U8*>(data);
+        return true;
+    }
+
+    const U8* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+  private:
+    const U8* m_data;
+    size_t m_size;
+};
+
+//! Stands in for the rest of the topology: supplies the virtual clock and collects text events
+class ReplayHarness : public Fw::PassiveComponentBase {
+  public:
+    ReplayHarness(ReplayResult& result, bool printTransitions)
+        : Fw::PassiveComponentBase("replay"), m_result(result), m_printTransitions(printTransitions) {
+        m_timePort.init();
+        m_timePort.addCallComp(this, timeCallback);
+        m_logTextPort.init();
+        m_logTextPort.addCallComp(this, logTextCallback);
+    }
+
+    Fw::InputTimePort* timePort() { return &m_timePort; }
+    Fw::InputLogTextPort* logTextPort() { return &m_logTextPort; }
+
+    void setTime(const Fw::Time& time) { m_now = time; }
+    void setTransitionId(FwEventIdType id) { m_transitionId = id; }
+
+  private:
+    static void timeCallback(Fw::PassiveComponentBase* callComp, FwIndexType portNum, Fw::Time& time) {
+        time = static_cast<ReplayHarness*>(callComp)->m_now;
+    }
+
+    static void logTextCallback(Fw::PassiveComponentBase* callComp,
+                                FwIndexType portNum,
+                                FwEventIdType id,
+                                Fw::Time& timeTag,
+                                const Fw::LogSeverity& severity,
+                                Fw::TextLogString& text) {
+        ReplayHarness* harness = static_cast<ReplayHarness*>(callComp);
+        if (id == harness->m_transitionId) {
+            harness->m_result.transitions++;
+            harness->digest(timeTag, text.toChar());
+            if (harness->m_printTransitions) {
+                (void)std::printf("%u.%06u %s\n", timeTag.getSeconds(), timeTag.getUSeconds(), text.toChar());
+            }
+        } else {
+            (void)std::fprintf(stderr, "%s\n", text.toChar());
+        }
+    }
+
+    //! Fold a transition into the result digest, so runs can be compared without printing them
+    void digest(const Fw::Time& timeTag, const char* text) {
+        U64 hash = m_result.transitionHash;
+        const U32 time[2] = {timeTag.getSeconds(), timeTag.getUSeconds()};
+        const U8* bytes = reinterpret_cast<const U8*>(time);
+        for (size_t i = 0; i < sizeof(time); i++) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+        }
+        for (; *text != '\0'; text++) {
+            hash = (hash ^ static_cast<U8>(*text)) * 0x100000001B3ULL;
+        }
+        m_result.transitionHash = hash;
+    }
+
+    ReplayResult& m_result;
+    bool m_printTransitions;
+    Fw::Time m_now;
+    FwEventIdType m_transitionId = 0;
+    Fw::InputTimePort m_timePort;
+    Fw::InputLogTextPort m_logTextPort;
+};
+
+//! Load alarm definitions: "alarmId chanId type lowLimit highLimit schedGroup period" per line, '#' comments
+bool loadAlarms(const char* path, FprimeTlmAlarm::TlmAlarm& alarm) {
+    FILE* file = std::fopen(path, "r");
+    if (file == nullptr) {
+        (void)std::fprintf(stderr, "Could not open alarm file %s\n", path);
+        return false;
+    }
+    static const char* const TYPE_NAMES[] = {"UINT8", "UINT16", "UINT32", "UINT64", "INT8",
+                                             "INT16", "INT32",  "INT64",  "FLOAT32", "FLOAT64"};
+    char line[256];
+    U32 lineNum = 0;
+    bool ok = true;
+    while (ok && std::fgets(line, sizeof(line), file) != nullptr) {
+        lineNum++;
+        char* comment = std::strchr(line, '#');
+        if (comment != nullptr) {
+            *comment = '\0';
+        }
+        unsigned int alarmId = 0;
+        char chanStr[32];
+        char typeStr[16];
+        double low = 0.0;
+        double high = 0.0;
+        unsigned int group = 0;
+        unsigned int period = 0;
+        const int fields =
+            std::sscanf(line, "%u %31s %15s %lf %lf %u %u", &alarmId, chanStr, typeStr, &low, &high, &group, &period);
+        if (fields <= 0) {
+            continue;
+        }
+        U32 type = 0;
+        while (fields == 7 && type < FW_NUM_ARRAY_ELEMENTS(TYPE_NAMES) && std::strcmp(typeStr, TYPE_NAMES[type]) != 0) {
+            type++;
+        }
+        if (fields != 7 || type == FW_NUM_ARRAY_ELEMENTS(TYPE_NAMES)) {
+            (void)std::fprintf(stderr, "%s:%u: expected 'alarmId chanId type low high group period'\n", path, lineNum);
+            ok = false;
+            break;
+        }
+        const FwChanIdType chanId = static_cast<FwChanIdType>(std::strtoul(chanStr, nullptr, 0));
+        ok = alarm.addAlarm(static_cast<U16>(alarmId), chanId, static_cast<FprimeTlmAlarm::AlarmValueType::T>(type),
+                            low, high, static_cast<U8>(group),
+                            static_cast<U16>(period)) == FprimeTlmAlarm::AlarmConfigStatus::OK;
+    }
+    (void)std::fclose(file);
+    return ok;
+}
+
+//! Feeds split channel updates to the TlmSplitter -> TlmAlarm chain, firing run ticks on the recording's clock
+class ReplaySink : public FprimeTlmAlarm::TlmPacketSplitter::UpdateSink {
+  public:
+    ReplaySink(const ReplayConfig& config,
+               ReplayHarness& harness,
+               FprimeTlmAlarm::TlmSplitter& splitter,
+               FprimeTlmAlarm::TlmAlarm& alarm,
+               ReplayResult& result)
+        : m_config(config),
+          m_harness(harness),
+          m_splitter(splitter),
+          m_alarm(alarm),
+          m_result(result),
+          m_started(false),
+          m_nextTickUsec(0),
+          m_pending(0) {}
+
+    //! Fire every tick the recording has moved past, at its boundary time, then queue the update. False when more
+    //! updates arrive between two ticks than the queue holds.
+    bool update(FwChanIdType id, const Fw::Time& timeTag, const U8* value, FwSizeType size) override {
+        const U64 recordUsec = static_cast<U64>(timeTag.getSeconds()) * 1000000U + timeTag.getUSeconds();
+        if (!m_started) {
+            m_started = true;
+            m_nextTickUsec = recordUsec + m_config.tickUsec;
+        }
+        while (recordUsec >= m_nextTickUsec) {
+            m_harness.setTime(Fw::Time(timeTag.getTimeBase(), timeTag.getContext(),
+                                       static_cast<U32>(m_nextTickUsec / 1000000U),
+                                       static_cast<U32>(m_nextTickUsec % 1000000U)));
+            tick();
+            m_nextTickUsec += m_config.tickUsec;
+        }
+
+        if (++m_pending > m_config.queueDepth) {
+            (void)std::fprintf(stderr, "More than %zu updates between ticks, raise the queue depth with -q\n",
+                               static_cast<size_t>(m_config.queueDepth));
+            return false;
+        }
+        m_harness.setTime(timeTag);
+        Fw::Time updateTime(timeTag);
+        Fw::TlmBuffer val(const_cast<U8*>(value), size);
+        m_splitter.get_TlmRecv_InputPort(0)->invoke(id, updateTime, val);
+        m_result.updates++;
+        return true;
+    }
+
+    //! Final tick evaluates whatever arrived after the last boundary
+    void finish() {
+        if (m_started) {
+            tick();
+        }
+    }
+
+  private:
+    void tick() {
+        const Clock::time_point tickStart = Clock::now();
+        m_alarm.get_run_InputPort(0)->invoke(m_config.context);
+        m_result.tickNs.push_back(static_cast<U32>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - tickStart).count()));
+        m_pending = 0;
+    }
+
+    const ReplayConfig& m_config;
+    ReplayHarness& m_harness;
+    FprimeTlmAlarm::TlmSplitter& m_splitter;
+    FprimeTlmAlarm::TlmAlarm& m_alarm;
+    ReplayResult& m_result;
+    bool m_started;
+    U64 m_nextTickUsec;
+    FwSizeType m_pending;
+};
+
+//! Split a stream of F´ packets each preceded by its size as a big-endian U32
+bool readSizePrefixed(const U8* const data, FwSizeType size, FprimeTlmAlarm::TlmPacketSplitter& packets) {
+    const U8* cursor = data;
+    const U8* const end = data + size;
+    while (end - cursor >= 4) {
+        const U32 packetSize = static_cast<U32>(readBe(cursor, 4));
+        cursor += 4;
+        if (static_cast<size_t>(end - cursor) < packetSize) {
+            (void)std::fprintf(stderr, "Recording truncated at offset %zu\n", static_cast<size_t>(cursor - data));
+            break;
+        }
+        if (!packets.split(cursor, packetSize)) {
+            return false;
+        }
+        cursor += packetSize;
+    }
+    return true;
+}
+
+//! Replay a recording through a freshly constructed TlmSplitter -> TlmAlarm chain
+bool runReplay(const ReplayConfig& config, const FprimeTlmAlarm::TlmDictionary* dictionary, ReplayResult& result) {
+    Recording recording;
+    if (!recording.open(config.recording)) {
+        (void)std::fprintf(stderr, "Could not map recording %s\n", config.recording);
+        return false;
+    }
+
+    ReplayHarness harness(result, config.printTransitions);
+    Fw::MallocAllocator allocator;
+    FprimeTlmAlarm::TlmSplitter splitter("tlmSplitter");
+    FprimeTlmAlarm::TlmAlarm alarm("tlmAlarm");
+    splitter.init(0);
+    alarm.init(config.queueDepth, 0);
+    splitter.set_TlmSend_OutputPort(0, alarm.get_TlmRecv_InputPort(0));
+    alarm.set_timeCaller_OutputPort(0, harness.timePort());
+    alarm.set_logTextOut_OutputPort(0, harness.logTextPort());
+    harness.setTransitionId(alarm.getIdBase() + FprimeTlmAlarm::TlmAlarmComponentBase::EVENTID_ALARMTRANSITION);
+    alarm.configure(0, allocator, config.maxAlarms, config.maxChannels, config.historyDepth);
+
+    if (!loadAlarms(config.alarms, alarm)) {
+        alarm.cleanup(allocator);
+        return false;
+    }
+    alarm.startWorkers(static_cast<U8>(config.threads - 1));
+
+    ReplaySink sink(config, harness, splitter, alarm, result);
+    FprimeTlmAlarm::TlmPacketSplitter packets(dictionary, sink);
+    const Clock::time_point replayStart = Clock::now();
+    bool ok = false;
+    if (config.frameSize == 0) {
+        ok = readSizePrefixed(recording.data(), recording.size(), packets);
+    } else {
+        FprimeTlmAlarm::CcsdsTmDeframer deframer(config.frameSize);
+        ok = deframer.deframe(recording.data(), recording.size(), packets);
+        result.frames = deframer.frames();
+        result.lostFrames = deframer.lostFrames();
+        result.skippedBytes = deframer.skippedBytes();
+    }
+    if (ok) {
+        sink.finish();
+    }
+    result.wallNs =
+        static_cast<U64>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - replayStart).count());
+    result.records = packets.packets();
+    result.cutShort = packets.cutShort();
+    alarm.stopWorkers();
+    alarm.cleanup(allocator);
+    return ok;
+}
+
+void printSummary(ReplayResult& result) {
+    std::vector<U32>& ticks = result.tickNs;
+    std::sort(ticks.begin(), ticks.end());
+    U64 tickTotal = 0;
+    for (U32 ns : ticks) {
+        tickTotal += ns;
+    }
+    const double seconds = static_cast<double>(result.wallNs) / 1e9;
+    if (result.frames > 0 || result.skippedBytes > 0) {
+        (void)std::printf("# frames         %llu\n", static_cast<unsigned long long>(result.frames));
+        (void)std::printf("# lost frames    %llu\n", static_cast<unsigned long long>(result.lostFrames));
+        (void)std::printf("# skipped bytes  %llu\n", static_cast<unsigned long long>(result.skippedBytes));
+    }
+    (void)std::printf("# records        %llu\n", static_cast<unsigned long long>(result.records));
+    (void)std::printf("# updates        %llu\n", static_cast<unsigned long long>(result.updates));
+    (void)std::printf("# cut short      %llu\n", static_cast<unsigned long long>(result.cutShort));
+    (void)std::printf("# transitions    %llu\n", static_cast<unsigned long long>(result.transitions));
+    (void)std::printf("# ticks          %zu\n", ticks.size());
+    (void)std::printf("# wall time      %.3f s\n", seconds);
+    (void)std::printf("# updates/s      %.0f\n", (seconds > 0.0) ? static_cast<double>(result.updates) / seconds : 0.0);
+    if (!ticks.empty()) {
+        (void)std::printf("# tick us mean/p50/p99/max  %.1f / %.1f / %.1f / %.1f\n",
+                          static_cast<double>(tickTotal) / static_cast<double>(ticks.size()) / 1e3,
+                          ticks[ticks.size() / 2] / 1e3, ticks[ticks.size() * 99 / 100] / 1e3,
+                          ticks.back() / 1e3);
+    }
+}
+
+//! Summarize a sweep: throughput and tick cost per thread count, relative to one thread
+void printScaling(std::vector<ReplayResult>& results) {
+    const double base = static_cast<double>(results[0].wallNs);
+    (void)std::printf("# threads  updates/s  tick p50 us  tick p99 us  speedup\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        std::vector<U32>& ticks = results[i].tickNs;
+        std::sort(ticks.begin(), ticks.end());
+        const double seconds = static_cast<double>(results[i].wallNs) / 1e9;
+        (void)std::printf("# %7zu  %9.0f  %11.1f  %11.1f  %7.2f\n", i + 1,
+                          (seconds > 0.0) ? static_cast<double>(results[i].updates) / seconds : 0.0,
+                          ticks.empty() ? 0.0 : ticks[ticks.size() / 2] / 1e3,
+                          ticks.empty() ? 0.0 : ticks[ticks.size() * 99 / 100] / 1e3,
+                          (results[i].wallNs > 0) ? base / static_cast<double>(results[i].wallNs) : 0.0);
+    }
+}
+
+void printUsage(const char* app) {
+    (void)std::printf(
+        "Usage: %s -r recording -a alarms [options]\n"
+        "-r\trecording of CCSDS TM frames, e.g. the GDS recv.bin\n"
+        "-F\tTM frame length, ComCfg.TmFrameFixedSize (default 1024). 0 reads F' packets each preceded by\n"
+        "\tits size as a big-endian U32\n"
+        "-a\talarm definitions\n"
+        "-d\tJSON topology dictionary, needed to split TlmChan and TlmPacketizer packets\n"
+        "-t\tvirtual microseconds per tick (default 1000000)\n"
+        "-c\trun context, i.e. scheduling group (default 0)\n"
+        "-q\tTlmAlarm queue depth (default 65536)\n"
+        "-n\tTlmAlarm alarm table size (default 4096)\n"
+        "-m\tTlmAlarm channel cache size (default 4096)\n"
+        "-j\tthreads evaluating alarms, the run thread plus j - 1 TlmAlarm workers (default 1)\n"
+        "-S\treplay once per thread count from 1 to -j and print the scaling\n",
+        app);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    ReplayConfig config;
+    I32 option = 0;
+    while ((option = getopt(argc, argv, "hr:F:a:d:t:c:q:n:m:j:S")) != -1) {
+        switch (option) {
+            case 'r':
+                config.recording = optarg;
+                break;
+            case 'F':
+                config.frameSize = static_cast<FwSizeType>(std::strtoull(optarg, nullptr, 0));
+                break;
+            case 'a':
+                config.alarms = optarg;
+                break;
+            case 'd':
+                config.dictionary = optarg;
+                break;
+            case 't':
+                config.tickUsec = std::strtoull(optarg, nullptr, 0);
+                break;
+            case 'c':
+                config.context = static_cast<U32>(std::strtoul(optarg, nullptr, 0));
+                break;
+            case 'q':
+                config.queueDepth = static_cast<FwSizeType>(std::strtoull(optarg, nullptr, 0));
+                break;
+            case 'n':
+                config.maxAlarms = static_cast<U16>(std::strtoul(optarg, nullptr, 0));
+                break;
+            case 'm':
+                config.maxChannels = static_cast<U16>(std::strtoul(optarg, nullptr, 0));
+                break;
+            case 'j':
+                config.threads = static_cast<U32>(std::strtoul(optarg, nullptr, 0));
+                break;
+            case 'S':
+                config.sweep = true;
+                break;
+            default:
+                printUsage(argv[0]);
+                return (option == 'h') ? 0 : 1;
+        }
+    }
+    if (config.recording == nullptr || config.alarms == nullptr || config.tickUsec == 0 || config.queueDepth == 0 ||
+        (config.frameSize != 0 && config.frameSize <= FprimeTlmAlarm::CcsdsTmDeframer::MIN_FRAME_SIZE) ||
+        config.maxAlarms == 0 || config.maxAlarms == FprimeTlmAlarm::TlmAlarm::NO_INDEX || config.maxChannels == 0 ||
+        config.maxChannels > FprimeTlmAlarm::TlmAlarm::MAX_CHANNELS_LIMIT || config.threads == 0 ||
+        config.threads > FprimeTlmAlarm::TlmAlarm::MAX_WORKERS + 1U) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    FprimeTlmAlarm::TlmDictionary dictionary;
+    if (config.dictionary != nullptr) {
+        if (!dictionary.load(config.dictionary)) {
+            return 1;
+        }
+        (void)std::fprintf(stderr, "%s: %zu channels, %zu packets\n", config.dictionary,
+                           static_cast<size_t>(dictionary.channelCount()),
+                           static_cast<size_t>(dictionary.packetCount()));
+    }
+    const FprimeTlmAlarm::TlmDictionary* splitWith = (config.dictionary != nullptr) ? &dictionary : nullptr;
+
+    Os::init();
+    if (!config.sweep) {
+        ReplayResult result;
+        if (!runReplay(config, splitWith, result)) {
+            return 1;
+        }
+        printSummary(result);
+        return 0;
+    }
+
+    // Transitions are printed once, later runs must reproduce them exactly
+    const U32 maxThreads = config.threads;
+    std::vector<ReplayResult> results(maxThreads);
+    for (U32 threads = 1; threads <= maxThreads; threads++) {
+        config.threads = threads;
+        config.printTransitions = (threads == 1);
+        ReplayResult& result = results[threads - 1];
+        if (!runReplay(config, splitWith, result)) {
+            return 1;
+        }
+        (void)std::printf("# --- %u thread(s)\n", threads);
+        printSummary(result);
+        if (result.transitions != results[0].transitions || result.transitionHash != results[0].transitionHash) {
+            (void)std::fprintf(stderr, "Transitions with %u threads differ from the serial replay\n", threads);
+            return 1;
+        }
+    }
+    printScaling(results);
+    return 0;
+}
@@ -0,0 +1,42 @@
+// ======================================================================
+// \title  TlmReplayTestMain.cpp
+// \author wmac
+// \brief  cpp file for TlmReplay recording decoding test main function
+// ======================================================================
+
+#include "TlmReplayTester.hpp"
+
+TEST(Nominal, dictionaryLayouts) {
+    FprimeTlmAlarm::TlmReplayTester tester;
+    tester.dictionaryLayouts();
+}
+
+TEST(Nominal, tlmChanEntries) {
+    FprimeTlmAlarm::TlmReplayTester tester;
+    tester.tlmChanEntries();
+}
+
+TEST(Nominal, packetizedSlots) {
+    FprimeTlmAlarm::TlmReplayTester tester;
+    tester.packetizedSlots();
+}
+
+TEST(OffNominal, cutShort) {
+    FprimeTlmAlarm::TlmReplayTester tester;
+    tester.cutShort();
+}
+
+TEST(Nominal, deframeSpanning) {
+    FprimeTlmAlarm::TlmReplayTester tester;
+    tester.deframeSpanning();
+}
+
+TEST(OffNominal, deframeResync) {
+    FprimeTlmAlarm::TlmReplayTester tester;
+    tester.deframeResync();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
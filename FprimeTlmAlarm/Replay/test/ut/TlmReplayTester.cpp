@@ -0,0 +1,446 @@
+// ======================================================================
+// \title  TlmReplayTester.cpp
+// \author wmac
+// \brief  cpp file for the TlmReplay recording decoding test harness
+// ======================================================================
+
+#include "TlmReplayTester.hpp"
+
+#include <cstring>
+
+namespace FprimeTlmAlarm {
+
+namespace {
+
+// Channel IDs of the dictionary fixture
+const FwChanIdType CHAN_TEMP = 0x100;    // U32
+const FwChanIdType CHAN_MODE = 0x101;    // Enum with a U8 representation
+const FwChanIdType CHAN_VEC = 0x102;     // Array of 3 U16
+const FwChanIdType CHAN_STATUS = 0x103;  // Struct with a string and an array member
+const FwChanIdType CHAN_NAME = 0x104;    // String of at most 6 bytes
+const FwChanIdType CHAN_UNKNOWN = 0x999;
+
+// TlmPacketizer packet of the dictionary fixture: CHAN_TEMP, CHAN_NAME, CHAN_MODE
+const FwTlmPacketizeIdType PACKET_ID = 5;
+
+// Slot sizes of the fixture channels, strings at their largest behind a FwSizeStoreType length
+const FwSizeType TEMP_SIZE = 4;
+const FwSizeType MODE_SIZE = 1;
+const FwSizeType VEC_SIZE = 3 * 2;
+const FwSizeType NAME_SLOT_SIZE = sizeof(FwSizeStoreType) + 6;
+const FwSizeType STATUS_SLOT_SIZE = 4 + sizeof(FwSizeStoreType) + 8 + 2 * 2 + 1;
+
+// TM frames the recordings are built from, no operational control field
+const FwSizeType FRAME_SIZE = 48;
+const FwSizeType FRAME_DATA_SIZE = FRAME_SIZE - CcsdsTmDeframer::PRIMARY_HEADER_SIZE - CcsdsTmDeframer::FECF_SIZE;
+const U16 SPACECRAFT_ID = 0x44;
+const U16 APID = 0x10;
+
+// Struct members are listed out of declaration order so that only their index gives the serialized order
+const char* const DICTIONARY = R"({
+  "metadata": {"deploymentName": "Ref"},
+  "typeDefinitions": [
+    {"kind": "enum", "qualifiedName": "Ref.Mode",
+     "representationType": {"name": "U8", "kind": "integer", "size": 8, "signed": false},
+     "enumeratedConstants": [{"name": "OFF", "value": 0}, {"name": "ON", "value": 1}], "default": "Ref.Mode.OFF"},
+    {"kind": "array", "qualifiedName": "Ref.Triple", "size": 3,
+     "elementType": {"name": "U16", "kind": "integer", "size": 16, "signed": false}, "default": [0, 0, 0]},
+    {"kind": "struct", "qualifiedName": "Ref.Status",
+     "members": {
+       "label": {"type": {"name": "string", "kind": "string", "size": 8}, "index": 1},
+       "mode": {"type": {"name": "Ref.Mode", "kind": "qualifiedIdentifier"}, "index": 3},
+       "count": {"type": {"name": "U32", "kind": "integer", "size": 32, "signed": false}, "index": 0},
+       "samples": {"type": {"name": "U16", "kind": "integer", "size": 16, "signed": false}, "index": 2, "size": 2}
+     }}
+  ],
+  "telemetryChannels": [
+    {"name": "Ref.c.temp", "id": 256, "type": {"name": "U32", "kind": "integer", "size": 32, "signed": false}},
+    {"name": "Ref.c.mode", "id": 257, "type": {"name": "Ref.Mode", "kind": "qualifiedIdentifier"}},
+    {"name": "Ref.c.vec", "id": 258, "type": {"name": "Ref.Triple", "kind": "qualifiedIdentifier"}},
+    {"name": "Ref.c.status", "id": 259, "type": {"name": "Ref.Status", "kind": "qualifiedIdentifier"}},
+    {"name": "Ref.c.name", "id": 260, "type": {"name": "string", "kind": "string", "size": 6}}
+  ],
+  "telemetryPacketSets": [
+    {"name": "RefPackets", "members": [
+      {"name": "Health", "id": 5, "group": 1, "members": ["Ref.c.temp", "Ref.c.name", "Ref.c.mode"]}
+    ], "omitted": ["Ref.c.vec", "Ref.c.status"]}
+  ]
+})";
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+// Construction and destruction
+// ----------------------------------------------------------------------
+
+TlmReplayTester ::TlmReplayTester()
+    : dictionary(), splitter(&this->dictionary, *this), updates(), recording(), vcCount() {
+    EXPECT_TRUE(this->dictionary.parse(DICTIONARY, "fixture"));
+}
+
+TlmReplayTester ::~TlmReplayTester() {}
+
+// ----------------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------------
+
+void TlmReplayTester ::dictionaryLayouts() {
+    ASSERT_EQ(5U, dictionary.channelCount());
+    ASSERT_EQ(1U, dictionary.packetCount());
+
+    // Enum with its representation type, array of its element type, strings at their largest
+    FwSizeType size = 0;
+    ASSERT_TRUE(dictionary.slotSize(CHAN_TEMP, size));
+    ASSERT_EQ(TEMP_SIZE, size);
+    ASSERT_TRUE(dictionary.slotSize(CHAN_MODE, size));
+    ASSERT_EQ(MODE_SIZE, size);
+    ASSERT_TRUE(dictionary.slotSize(CHAN_VEC, size));
+    ASSERT_EQ(VEC_SIZE, size);
+    ASSERT_TRUE(dictionary.slotSize(CHAN_NAME, size));
+    ASSERT_EQ(NAME_SLOT_SIZE, size);
+    ASSERT_TRUE(dictionary.slotSize(CHAN_STATUS, size));
+    ASSERT_EQ(STATUS_SLOT_SIZE, size);
+    ASSERT_FALSE(dictionary.slotSize(CHAN_UNKNOWN, size));
+
+    // The label length sits after count only when members are laid out by index
+    std::vector<U8> status = statusValue(0x00030000, "abc");
+    ASSERT_TRUE(dictionary.valueSize(CHAN_STATUS, status.data(), status.size(), size));
+    ASSERT_EQ(status.size(), size);
+    ASSERT_FALSE(dictionary.valueSize(CHAN_STATUS, status.data(), status.size() - 1, size));
+
+    // Strings take their serialized length, up to their declared size
+    std::vector<U8> name;
+    putString(name, "abcdef");
+    ASSERT_TRUE(dictionary.valueSize(CHAN_NAME, name.data(), name.size(), size));
+    ASSERT_EQ(name.size(), size);
+    name.clear();
+    putString(name, "abcdefg");
+    ASSERT_FALSE(dictionary.valueSize(CHAN_NAME, name.data(), name.size(), size));
+    ASSERT_FALSE(dictionary.valueSize(CHAN_UNKNOWN, name.data(), name.size(), size));
+
+    const std::vector<FwChanIdType>* channels = dictionary.packet(PACKET_ID);
+    ASSERT_NE(nullptr, channels);
+    ASSERT_EQ(3U, channels->size());
+    ASSERT_EQ(CHAN_TEMP, (*channels)[0]);
+    ASSERT_EQ(CHAN_NAME, (*channels)[1]);
+    ASSERT_EQ(CHAN_MODE, (*channels)[2]);
+    ASSERT_EQ(nullptr, dictionary.packet(PACKET_ID + 1));
+
+    TlmDictionary broken;
+    ASSERT_FALSE(broken.parse(R"({"telemetryChannels": [)", "broken"));
+}
+
+void TlmReplayTester ::tlmChanEntries() {
+    std::vector<U8> packet = fprimePacket(TlmPacketSplitter::PACKET_TELEM);
+    putEntry(packet, CHAN_TEMP, 10, {0, 0, 0, 42});
+    putEntry(packet, CHAN_STATUS, 11, statusValue(7, "ab"));
+    std::vector<U8> name;
+    putString(name, "xyz");
+    putEntry(packet, CHAN_NAME, 12, name);
+    putEntry(packet, CHAN_MODE, 13, {1});
+    putEntry(packet, CHAN_VEC, 14, {0, 1, 0, 2, 0, 3});
+    ASSERT_TRUE(split(packet));
+
+    const FwChanIdType ids[] = {CHAN_TEMP, CHAN_STATUS, CHAN_NAME, CHAN_MODE, CHAN_VEC};
+    const FwSizeType sizes[] = {TEMP_SIZE, statusValue(7, "ab").size(), name.size(), MODE_SIZE, VEC_SIZE};
+    ASSERT_EQ(5U, updates.size());
+    for (U32 i = 0; i < 5; i++) {
+        ASSERT_EQ(ids[i], updates[i].id);
+        ASSERT_EQ(10 + i, updates[i].seconds);
+        ASSERT_EQ(sizes[i], updates[i].value.size());
+    }
+    ASSERT_EQ(statusValue(7, "ab"), updates[1].value);
+    ASSERT_EQ(name, updates[2].value);
+    ASSERT_EQ(1U, splitter.packets());
+    ASSERT_EQ(0U, splitter.cutShort());
+}
+
+void TlmReplayTester ::packetizedSlots() {
+    ASSERT_TRUE(split(packetizedPacket(20, 42, "abc", 1)));
+
+    // Every slot is passed whole with the packet's time tag, the string slot including its unused bytes
+    ASSERT_EQ(3U, updates.size());
+    ASSERT_EQ(CHAN_TEMP, updates[0].id);
+    ASSERT_EQ(CHAN_NAME, updates[1].id);
+    ASSERT_EQ(CHAN_MODE, updates[2].id);
+    for (const Update& update : updates) {
+        ASSERT_EQ(20U, update.seconds);
+    }
+    ASSERT_EQ(std::vector<U8>({0, 0, 0, 42}), updates[0].value);
+    ASSERT_EQ(NAME_SLOT_SIZE, updates[1].value.size());
+    std::vector<U8> name;
+    putString(name, "abc");
+    ASSERT_EQ(0, std::memcmp(name.data(), updates[1].value.data(), name.size()));
+    ASSERT_EQ(std::vector<U8>({1}), updates[2].value);
+    ASSERT_EQ(0U, splitter.cutShort());
+}
+
+void TlmReplayTester ::cutShort() {
+    // Unknown channel: entries before it are kept, nothing after it can be located
+    std::vector<U8> packet = fprimePacket(TlmPacketSplitter::PACKET_TELEM);
+    putEntry(packet, CHAN_TEMP, 1, {0, 0, 0, 1});
+    putEntry(packet, CHAN_UNKNOWN, 1, {0, 0, 0, 2});
+    putEntry(packet, CHAN_MODE, 1, {1});
+    ASSERT_TRUE(split(packet));
+    ASSERT_EQ(1U, updates.size());
+    ASSERT_EQ(1U, splitter.cutShort());
+
+    // Value truncated inside a string
+    packet = fprimePacket(TlmPacketSplitter::PACKET_TELEM);
+    putEntry(packet, CHAN_TEMP, 2, {0, 0, 0, 1});
+    putEntry(packet, CHAN_STATUS, 2, statusValue(1, "abcd"));
+    packet.resize(packet.size() - 6);
+    ASSERT_TRUE(split(packet));
+    ASSERT_EQ(2U, updates.size());
+    ASSERT_EQ(2U, splitter.cutShort());
+
+    // Leftover bytes too short for another entry
+    packet = fprimePacket(TlmPacketSplitter::PACKET_TELEM);
+    putEntry(packet, CHAN_TEMP, 3, {0, 0, 0, 1});
+    putBe(packet, CHAN_TEMP, sizeof(FwChanIdType));
+    ASSERT_TRUE(split(packet));
+    ASSERT_EQ(3U, updates.size());
+    ASSERT_EQ(3U, splitter.cutShort());
+
+    // TlmPacketizer packet missing its last slot
+    packet = packetizedPacket(4, 1, "a", 0);
+    packet.pop_back();
+    ASSERT_TRUE(split(packet));
+    ASSERT_EQ(5U, updates.size());
+    ASSERT_EQ(CHAN_NAME, updates.back().id);
+    ASSERT_EQ(4U, splitter.cutShort());
+
+    // Unknown TlmPacketizer packet
+    packet = fprimePacket(TlmPacketSplitter::PACKET_PACKETIZED_TLM);
+    putBe(packet, PACKET_ID + 1, sizeof(FwTlmPacketizeIdType));
+    putTime(packet, 5);
+    putBe(packet, 0, TEMP_SIZE);
+    ASSERT_TRUE(split(packet));
+    ASSERT_EQ(5U, updates.size());
+    ASSERT_EQ(5U, splitter.cutShort());
+
+    // Packets other than telemetry are not split at all
+    packet = fprimePacket(2);
+    packet.resize(packet.size() + 16, 0);
+    ASSERT_TRUE(split(packet));
+    ASSERT_EQ(5U, updates.size());
+    ASSERT_EQ(5U, splitter.cutShort());
+    ASSERT_EQ(6U, splitter.packets());
+
+    // Without a dictionary a TlmChan value is the rest of the packet and TlmPacketizer packets cannot be split
+    TlmPacketSplitter bare(nullptr, *this);
+    packet = fprimePacket(TlmPacketSplitter::PACKET_TELEM);
+    putEntry(packet, CHAN_VEC, 6, {0, 1, 0, 2, 0, 3});
+    ASSERT_TRUE(bare.split(packet.data(), packet.size()));
+    packet = packetizedPacket(7, 1, "a", 0);
+    ASSERT_TRUE(bare.split(packet.data(), packet.size()));
+    ASSERT_EQ(6U, updates.size());
+    ASSERT_EQ(VEC_SIZE, updates.back().value.size());
+    ASSERT_EQ(1U, bare.cutShort());
+}
+
+void TlmReplayTester ::deframeSpanning() {
+    std::vector<U8> first = fprimePacket(TlmPacketSplitter::PACKET_TELEM);
+    putEntry(first, CHAN_TEMP, 30, {0, 0, 0, 1});
+    std::vector<U8> second = fprimePacket(TlmPacketSplitter::PACKET_TELEM);
+    putEntry(second, CHAN_STATUS, 31, statusValue(2, "abcdefgh"));
+    std::vector<U8> empty;
+    putString(empty, "");
+    putEntry(second, CHAN_NAME, 32, empty);
+    ASSERT_GT(second.size(), FRAME_DATA_SIZE);
+
+    addPackets({spacePacket(APID, first), spacePacket(APID, second)}, 0);
+    putBe(recording, CcsdsTmDeframer::ATTACHED_SYNC_MARKER, sizeof(U32));
+    const std::vector<U8> idle(FRAME_DATA_SIZE, 0x55);
+    addFrame(0, CcsdsTmDeframer::FHP_IDLE_DATA, idle.data());
+    addPackets({spacePacket(APID, packetizedPacket(33, 2, "ab", 1))}, 1);
+    addPackets({spacePacket(APID, first)}, 0);
+
+    CcsdsTmDeframer deframer(FRAME_SIZE);
+    ASSERT_TRUE(deframer.deframe(recording.data(), recording.size(), splitter));
+
+    const FwChanIdType ids[] = {CHAN_TEMP, CHAN_STATUS, CHAN_NAME, CHAN_TEMP, CHAN_NAME, CHAN_MODE, CHAN_TEMP};
+    const U32 seconds[] = {30, 31, 32, 33, 33, 33, 30};
+    ASSERT_EQ(7U, updates.size());
+    for (U32 i = 0; i < 7; i++) {
+        ASSERT_EQ(ids[i], updates[i].id);
+        ASSERT_EQ(seconds[i], updates[i].seconds);
+    }
+    ASSERT_EQ(static_cast<U64>((recording.size() - sizeof(U32)) / FRAME_SIZE), deframer.frames());
+    ASSERT_EQ(0U, deframer.lostFrames());
+    ASSERT_EQ(0U, deframer.skippedBytes());
+    // Idle packets never reach the splitter
+    ASSERT_EQ(4U, splitter.packets());
+    ASSERT_EQ(0U, splitter.cutShort());
+}
+
+void TlmReplayTester ::deframeResync() {
+    // Check value of CRC-16/CCITT-FALSE
+    const char* const check = "123456789";
+    ASSERT_EQ(0x29B1, CcsdsTmDeframer::crc16(reinterpret_cast<const U8*>(check), std::strlen(check)));
+
+    std::vector<U8> first = fprimePacket(TlmPacketSplitter::PACKET_TELEM);
+    putEntry(first, CHAN_TEMP, 40, {0, 0, 0, 1});
+    std::vector<U8> second = fprimePacket(TlmPacketSplitter::PACKET_TELEM);
+    putEntry(second, CHAN_STATUS, 41, statusValue(2, "abcdefgh"));
+    std::vector<U8> empty;
+    putString(empty, "");
+    putEntry(second, CHAN_NAME, 42, empty);
+
+    // Leading garbage, then a frame failing its check
+    const FwSizeType GARBAGE = 5;
+    recording.assign(GARBAGE, 0xA5);
+    addPackets({spacePacket(APID, first)}, 0);
+    recording[GARBAGE + CcsdsTmDeframer::PRIMARY_HEADER_SIZE + 3] ^= 0xFF;
+    addPackets({spacePacket(APID, first), spacePacket(APID, second)}, 0);
+
+    // The frame holding the start of the second packet is lost
+    const FwSizeType gap = recording.size();
+    addPackets({spacePacket(APID, second)}, 0);
+    recording.erase(recording.begin() + static_cast<std::ptrdiff_t>(gap),
+                    recording.begin() + static_cast<std::ptrdiff_t>(gap + FRAME_SIZE));
+    addPackets({spacePacket(APID, first)}, 0);
+
+    // Partial frame at the end
+    const FwSizeType TAIL = 10;
+    recording.insert(recording.end(), TAIL, 0);
+
+    CcsdsTmDeframer deframer(FRAME_SIZE);
+    ASSERT_TRUE(deframer.deframe(recording.data(), recording.size(), splitter));
+
+    const FwChanIdType ids[] = {CHAN_TEMP, CHAN_STATUS, CHAN_NAME, CHAN_TEMP};
+    const U32 seconds[] = {40, 41, 42, 40};
+    ASSERT_EQ(4U, updates.size());
+    for (U32 i = 0; i < 4; i++) {
+        ASSERT_EQ(ids[i], updates[i].id);
+        ASSERT_EQ(seconds[i], updates[i].seconds);
+    }
+    ASSERT_EQ(1U, deframer.lostFrames());
+    ASSERT_EQ(static_cast<U64>(GARBAGE + FRAME_SIZE + TAIL), deframer.skippedBytes());
+    ASSERT_EQ(static_cast<U64>((recording.size() - GARBAGE - TAIL) / FRAME_SIZE - 1), deframer.frames());
+    ASSERT_EQ(0U, splitter.cutShort());
+}
+
+// ----------------------------------------------------------------------
+// Handlers
+// ----------------------------------------------------------------------
+
+bool TlmReplayTester ::update(FwChanIdType id, const Fw::Time& timeTag, const U8* value, FwSizeType size) {
+    this->updates.push_back({id, timeTag.getSeconds(), std::vector<U8>(value, value + size)});
+    return true;
+}
+
+// ----------------------------------------------------------------------
+// Helper functions
+// ----------------------------------------------------------------------
+
+void TlmReplayTester ::putBe(std::vector<U8>& out, U64 value, FwSizeType size) {
+    for (FwSizeType i = size; i > 0; i--) {
+        out.push_back(static_cast<U8>(value >> (8 * (i - 1))));
+    }
+}
+
+void TlmReplayTester ::putTime(std::vector<U8>& out, U32 seconds) {
+    putBe(out, TimeBase::TB_WORKSTATION_TIME, sizeof(FwTimeBaseStoreType));
+    putBe(out, 0, sizeof(FwTimeContextStoreType));
+    putBe(out, seconds, sizeof(U32));
+    putBe(out, 0, sizeof(U32));
+}
+
+void TlmReplayTester ::putString(std::vector<U8>& out, const char* text) {
+    const FwSizeType length = std::strlen(text);
+    putBe(out, length, sizeof(FwSizeStoreType));
+    out.insert(out.end(), text, text + length);
+}
+
+std::vector<U8> TlmReplayTester ::statusValue(U32 count, const char* label) {
+    std::vector<U8> value;
+    putBe(value, count, sizeof(U32));
+    putString(value, label);
+    putBe(value, 0x1111, sizeof(U16));
+    putBe(value, 0x2222, sizeof(U16));
+    putBe(value, 1, sizeof(U8));
+    return value;
+}
+
+std::vector<U8> TlmReplayTester ::fprimePacket(U32 descriptor) {
+    std::vector<U8> packet;
+    putBe(packet, descriptor, sizeof(FwPacketDescriptorType));
+    return packet;
+}
+
+void TlmReplayTester ::putEntry(std::vector<U8>& packet, FwChanIdType id, U32 seconds, const std::vector<U8>& value) {
+    putBe(packet, id, sizeof(FwChanIdType));
+    putTime(packet, seconds);
+    packet.insert(packet.end(), value.begin(), value.end());
+}
+
+std::vector<U8> TlmReplayTester ::packetizedPacket(U32 seconds, U32 temp, const char* name, U8 mode) {
+    std::vector<U8> packet = fprimePacket(TlmPacketSplitter::PACKET_PACKETIZED_TLM);
+    putBe(packet, PACKET_ID, sizeof(FwTlmPacketizeIdType));
+    putTime(packet, seconds);
+    putBe(packet, temp, TEMP_SIZE);
+    // String slots are always their largest size, the unused bytes zero
+    const FwSizeType slotStart = packet.size();
+    putString(packet, name);
+    packet.resize(slotStart + NAME_SLOT_SIZE, 0);
+    putBe(packet, mode, MODE_SIZE);
+    return packet;
+}
+
+std::vector<U8> TlmReplayTester ::spacePacket(U16 apid, const std::vector<U8>& payload) {
+    std::vector<U8> packet;
+    // Version 1 telemetry packet without secondary header, unsegmented
+    putBe(packet, apid & 0x7FF, sizeof(U16));
+    putBe(packet, 0xC000, sizeof(U16));
+    putBe(packet, payload.size() - 1, sizeof(U16));
+    packet.insert(packet.end(), payload.begin(), payload.end());
+    return packet;
+}
+
+void TlmReplayTester ::addFrame(U8 vcid, U16 firstHeader, const U8* data) {
+    std::vector<U8> frame;
+    putBe(frame, static_cast<U64>(SPACECRAFT_ID << 4) | static_cast<U64>(vcid << 1), sizeof(U16));
+    putBe(frame, 0, sizeof(U8));
+    putBe(frame, this->vcCount[vcid]++, sizeof(U8));
+    putBe(frame, firstHeader, sizeof(U16));
+    frame.insert(frame.end(), data, data + FRAME_DATA_SIZE);
+    putBe(frame, CcsdsTmDeframer::crc16(frame.data(), frame.size()), CcsdsTmDeframer::FECF_SIZE);
+    this->recording.insert(this->recording.end(), frame.begin(), frame.end());
+}
+
+void TlmReplayTester ::addPackets(const std::vector<std::vector<U8>>& packets, U8 vcid) {
+    std::vector<U8> stream;
+    std::vector<FwSizeType> starts;
+    for (const std::vector<U8>& packet : packets) {
+        starts.push_back(stream.size());
+        stream.insert(stream.end(), packet.begin(), packet.end());
+    }
+    // An idle packet needs its header and at least one byte
+    if (stream.size() % FRAME_DATA_SIZE != 0) {
+        FwSizeType fill = FRAME_DATA_SIZE - stream.size() % FRAME_DATA_SIZE;
+        if (fill <= CcsdsTmDeframer::SPACE_PACKET_HEADER_SIZE) {
+            fill += FRAME_DATA_SIZE;
+        }
+        starts.push_back(stream.size());
+        const std::vector<U8> padding(fill - CcsdsTmDeframer::SPACE_PACKET_HEADER_SIZE, 0);
+        const std::vector<U8> idle = spacePacket(CcsdsTmDeframer::IDLE_APID, padding);
+        stream.insert(stream.end(), idle.begin(), idle.end());
+    }
+    for (FwSizeType offset = 0; offset < stream.size(); offset += FRAME_DATA_SIZE) {
+        U16 firstHeader = CcsdsTmDeframer::FHP_NO_PACKET_START;
+        for (const FwSizeType start : starts) {
+            if (start >= offset && start < offset + FRAME_DATA_SIZE) {
+                firstHeader = static_cast<U16>(start - offset);
+                break;
+            }
+        }
+        addFrame(vcid, firstHeader, stream.data() + offset);
+    }
+}
+
+bool TlmReplayTester ::split(const std::vector<U8>& packet) {
+    return this->splitter.split(packet.data(), packet.size());
+}
+
+}  // namespace FprimeTlmAlarm
@@ -0,0 +1,130 @@
+// ======================================================================
+// \title  TlmReplayTester.hpp
+// \author wmac
+// \brief  hpp file for the TlmReplay recording decoding test harness
+// ======================================================================
+
+#ifndef FprimeTlmAlarm_TlmReplayTester_HPP
+#define FprimeTlmAlarm_TlmReplayTester_HPP
+
+#include "FprimeTlmAlarm/Replay/CcsdsTmDeframer.hpp"
+#include "FprimeTlmAlarm/Replay/TlmDictionary.hpp"
+#include "FprimeTlmAlarm/Replay/TlmPacketSplitter.hpp"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace FprimeTlmAlarm {
+
+class TlmReplayTester final : public TlmPacketSplitter::UpdateSink {
+  public:
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct object TlmReplayTester, loading the dictionary fixture
+    TlmReplayTester();
+
+    //! Destroy object TlmReplayTester
+    ~TlmReplayTester();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+    //! Channel layouts follow struct member indices, array sizes, string bounds and enum representations
+    void dictionaryLayouts();
+
+    //! A TlmChan packet is split into each of its entries with their own time tags
+    void tlmChanEntries();
+
+    //! A TlmPacketizer packet is split into a fixed slot per channel with the packet's time tag
+    void packetizedSlots();
+
+    //! Packets with unknown channels or packets, or truncated, are counted as cut short
+    void cutShort();
+
+    //! Space packets are reassembled across frames, idle data and the sync marker are skipped
+    void deframeSpanning();
+
+    //! Corrupted frames are skipped and a frame count gap drops the packet it interrupted
+    void deframeResync();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Handlers
+    // ----------------------------------------------------------------------
+
+    //! Record every update split out of a packet
+    bool update(FwChanIdType id, const Fw::Time& timeTag, const U8* value, FwSizeType size) override;
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper functions
+    // ----------------------------------------------------------------------
+
+    //! Channel update passed to the sink
+    struct Update {
+        FwChanIdType id;
+        U32 seconds;
+        std::vector<U8> value;
+    };
+
+    //! Append value as a big-endian integer of size bytes
+    static void putBe(std::vector<U8>& out, U64 value, FwSizeType size);
+
+    //! Append a serialized time tag at seconds
+    static void putTime(std::vector<U8>& out, U32 seconds);
+
+    //! Append a length-prefixed string
+    static void putString(std::vector<U8>& out, const char* text);
+
+    //! Serialized CHAN_STATUS value: count, label, two samples and a mode
+    static std::vector<U8> statusValue(U32 count, const char* label);
+
+    //! Empty F´ packet with descriptor
+    static std::vector<U8> fprimePacket(U32 descriptor);
+
+    //! Append a (channel ID, time tag, value) entry to a TlmChan packet
+    static void putEntry(std::vector<U8>& packet, FwChanIdType id, U32 seconds, const std::vector<U8>& value);
+
+    //! TlmPacketizer packet PACKET_ID at seconds with temp, a name slot and mode
+    static std::vector<U8> packetizedPacket(U32 seconds, U32 temp, const char* name, U8 mode);
+
+    //! Space packet of apid carrying payload
+    static std::vector<U8> spacePacket(U16 apid, const std::vector<U8>& payload);
+
+    //! Append one TM frame of virtual channel vcid, taking the next frame count
+    void addFrame(U8 vcid, U16 firstHeader, const U8* data);
+
+    //! Frame space packets back to back on virtual channel vcid, filling the last frame with an idle packet
+    void addPackets(const std::vector<std::vector<U8>>& packets, U8 vcid);
+
+    //! Split packet with the fixture dictionary
+    bool split(const std::vector<U8>& packet);
+
+  private:
+    // ----------------------------------------------------------------------
+    // Member variables
+    // ----------------------------------------------------------------------
+
+    //! Dictionary fixture
+    TlmDictionary dictionary;
+
+    //! Splitter under test, feeding this sink
+    TlmPacketSplitter splitter;
+
+    //! Updates received, in order
+    std::vector<Update> updates;
+
+    //! Recording of TM frames built by the test
+    std::vector<U8> recording;
+
+    //! Next frame count of each virtual channel
+    U8 vcCount[CcsdsTmDeframer::NUM_VIRTUAL_CHANNELS];
+};
+
+}  // namespace FprimeTlmAlarm
+
+#endif